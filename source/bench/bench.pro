@@ -0,0 +1,12 @@
+#-------------------------------------------------
+# BENCHMARKS
+#-------------------------------------------------
+# Console programs used to measure performance.
+# Build in release mode.
+
+TEMPLATE = subdirs
+
+SUBDIRS += \
+    geometry_bench \
+    macro_bench \
+    random_bench
@@ -0,0 +1,719 @@
+//---------------------------------------------------------------------------
+// PROJECT      : Asteroid Style Game
+// COPYRIGHT    : Andy Thomas (C) 2019
+// WEB URL      : https://kuiper.zone
+// LICENSE      : GPLv3
+//---------------------------------------------------------------------------
+
+// Microbenchmark of PairXy and the geometry kernels built on it. Each kernel
+// is measured in three variants, and some also in a fourth:
+//
+//   scalar     - PairXy as used by the game, one point at a time
+//   inlined    - same arithmetic on a local plain struct, for comparison
+//   vectorised - structure of arrays loops, written so that the compiler can
+//                use SIMD instructions (check with -O3 or -ftree-vectorize)
+//   batch      - the array functions of pair_span.h
+//
+// A checksum is printed with each result. Variants of a kernel should agree,
+// other than in the last digits where the order of operations differs.
+//
+// The SIMD kernels used by Universe and entities are then measured at each
+// level supported by the CPU. Before timing, the result of each is checked
+// to be bit for bit identical to the per-entity logic which they replace,
+// over data which includes NaN, zero and boundary values. The exit code is
+// non-zero if any differs.
+
+#include "game/pair_xy.h"
+#include "game/pair_span.h"
+#include "game/internal/simd_kernels.h"
+
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <limits>
+#include <vector>
+
+using namespace Game;
+
+namespace {
+
+// Points per kernel call
+const int PointCount = 1024;
+
+// Inlined equivalent of PairXy
+struct Xy
+{
+    double x;
+    double y;
+};
+
+inline Xy operator+(Xy a, Xy b) { return {a.x + b.x, a.y + b.y}; }
+inline Xy operator-(Xy a, Xy b) { return {a.x - b.x, a.y - b.y}; }
+inline Xy operator*(Xy a, double k) { return {a.x * k, a.y * k}; }
+inline Xy operator/(Xy a, double k) { return {a.x / k, a.y / k}; }
+inline double abs(Xy a) { return std::sqrt(a.x * a.x + a.y * a.y); }
+
+inline Xy throttle(Xy a, double max)
+{
+    return {a.x > max ? max : (a.x < -max ? -max : a.x),
+        a.y > max ? max : (a.y < -max ? -max : a.y)};
+}
+
+// Input data in both layouts
+struct Data
+{
+    std::vector<PairXy> pairs;
+    std::vector<Xy> xys;
+    std::vector<double> xs;
+    std::vector<double> ys;
+    std::vector<double> radii;
+
+    // Output buffers
+    std::vector<PairXy> outPairs;
+    std::vector<Xy> outXys;
+    std::vector<double> outXs;
+    std::vector<double> outYs;
+
+    Data()
+    {
+        std::srand(1);
+
+        for(int n = 0; n < PointCount; ++n)
+        {
+            double x = 800.0 * std::rand() / RAND_MAX;
+            double y = 600.0 * std::rand() / RAND_MAX;
+            double r = 5.0 + 25.0 * std::rand() / RAND_MAX;
+
+            pairs.push_back(PairXy(x, y));
+            xys.push_back({x, y});
+            xs.push_back(x);
+            ys.push_back(y);
+            radii.push_back(r);
+        }
+
+        outPairs.resize(PointCount);
+        outXys.resize(PointCount);
+        outXs.resize(PointCount);
+        outYs.resize(PointCount);
+    }
+};
+
+volatile double sink = 0;
+
+// Calls func until at least 0.2 seconds have elapsed, and reports mean
+// nanoseconds per element, where func processes count elements per call.
+template <typename F>
+void measure(const char *kernel, const char *variant, long count, F func)
+{
+    using Clock = std::chrono::steady_clock;
+
+    double check = func();
+    long calls = 1;
+    auto t0 = Clock::now();
+    double elapsed = 0;
+
+    while(elapsed < 0.2)
+    {
+        for(int n = 0; n < 16; ++n)
+        {
+            sink = sink + func();
+        }
+
+        calls += 16;
+        elapsed = std::chrono::duration<double>(Clock::now() - t0).count();
+    }
+
+    std::printf("%-10s %-11s %9.3f ns/elem   check %.9g\n", kernel, variant,
+        1e9 * elapsed / ((calls - 1) * static_cast<double>(count)), check);
+}
+
+//---------------------------------------------------------------------------
+// KERNELS
+//---------------------------------------------------------------------------
+
+void benchArith(Data &d)
+{
+    const double k = 1.25;
+
+    measure("arith", "scalar", PointCount, [&d, k]
+    {
+        double sum = 0;
+
+        for(int n = 0; n < PointCount - 1; ++n)
+        {
+            PairXy p = (d.pairs[n] + d.pairs[n + 1]) * k - d.pairs[n] / k;
+            sum += p.x() + p.y();
+        }
+
+        return sum;
+    });
+
+    measure("arith", "inlined", PointCount, [&d, k]
+    {
+        double sum = 0;
+
+        for(int n = 0; n < PointCount - 1; ++n)
+        {
+            Xy p = (d.xys[n] + d.xys[n + 1]) * k - d.xys[n] / k;
+            sum += p.x + p.y;
+        }
+
+        return sum;
+    });
+
+    measure("arith", "vectorised", PointCount, [&d, k]
+    {
+        const double *xs = d.xs.data();
+        const double *ys = d.ys.data();
+        double sx = 0, sy = 0;
+
+        for(int n = 0; n < PointCount - 1; ++n)
+        {
+            sx += (xs[n] + xs[n + 1]) * k - xs[n] / k;
+            sy += (ys[n] + ys[n + 1]) * k - ys[n] / k;
+        }
+
+        return sx + sy;
+    });
+}
+
+void benchAbs(Data &d)
+{
+    measure("abs", "scalar", PointCount, [&d]
+    {
+        double sum = 0;
+
+        for(int n = 0; n < PointCount; ++n)
+        {
+            sum += d.pairs[n].abs();
+        }
+
+        return sum;
+    });
+
+    measure("abs", "inlined", PointCount, [&d]
+    {
+        double sum = 0;
+
+        for(int n = 0; n < PointCount; ++n)
+        {
+            sum += abs(d.xys[n]);
+        }
+
+        return sum;
+    });
+
+    measure("abs", "vectorised", PointCount, [&d]
+    {
+        const double *xs = d.xs.data();
+        const double *ys = d.ys.data();
+        double *out = d.outXs.data();
+
+        for(int n = 0; n < PointCount; ++n)
+        {
+            out[n] = std::sqrt(xs[n] * xs[n] + ys[n] * ys[n]);
+        }
+
+        double sum = 0;
+
+        for(int n = 0; n < PointCount; ++n)
+        {
+            sum += out[n];
+        }
+
+        return sum;
+    });
+}
+
+void benchThrottle(Data &d)
+{
+    const double max = 400;
+
+    measure("throttle", "scalar", PointCount, [&d, max]
+    {
+        for(int n = 0; n < PointCount; ++n)
+        {
+            d.outPairs[n] = d.pairs[n].throttle(max);
+        }
+
+        return d.outPairs[PointCount / 2].x();
+    });
+
+    measure("throttle", "inlined", PointCount, [&d, max]
+    {
+        for(int n = 0; n < PointCount; ++n)
+        {
+            d.outXys[n] = throttle(d.xys[n], max);
+        }
+
+        return d.outXys[PointCount / 2].x;
+    });
+
+    measure("throttle", "vectorised", PointCount, [&d, max]
+    {
+        const double *xs = d.xs.data();
+        const double *ys = d.ys.data();
+        double *ox = d.outXs.data();
+        double *oy = d.outYs.data();
+
+        for(int n = 0; n < PointCount; ++n)
+        {
+            // Compiles to min/max instructions
+            double x = xs[n] < -max ? -max : xs[n];
+            double y = ys[n] < -max ? -max : ys[n];
+            ox[n] = x > max ? max : x;
+            oy[n] = y > max ? max : y;
+        }
+
+        return ox[PointCount / 2];
+    });
+
+    measure("throttle", "batch", PointCount, [&d, max]
+    {
+        throttle(d.pairs.data(), d.outPairs.data(), PointCount, max);
+        return d.outPairs[PointCount / 2].x();
+    });
+}
+
+// Rotation of a polygon by one angle, as GameEntity::draw()
+void benchRotate(Data &d)
+{
+    const double alpha = 0.3;
+
+    measure("rotate", "scalar", PointCount, [&d, alpha]
+    {
+        for(int n = 0; n < PointCount; ++n)
+        {
+            d.outPairs[n] = d.pairs[n].rotate(alpha);
+        }
+
+        return d.outPairs[PointCount - 1].y();
+    });
+
+    measure("rotate", "inlined", PointCount, [&d, alpha]
+    {
+        // Hoisted sin and cos
+        double cs = std::cos(alpha);
+        double sn = std::sin(alpha);
+
+        for(int n = 0; n < PointCount; ++n)
+        {
+            Xy p = d.xys[n];
+            d.outXys[n] = {cs * p.x - sn * p.y, sn * p.x + cs * p.y};
+        }
+
+        return d.outXys[PointCount - 1].y;
+    });
+
+    measure("rotate", "vectorised", PointCount, [&d, alpha]
+    {
+        double cs = std::cos(alpha);
+        double sn = std::sin(alpha);
+        const double *xs = d.xs.data();
+        const double *ys = d.ys.data();
+        double *ox = d.outXs.data();
+        double *oy = d.outYs.data();
+
+        for(int n = 0; n < PointCount; ++n)
+        {
+            ox[n] = cs * xs[n] - sn * ys[n];
+            oy[n] = sn * xs[n] + cs * ys[n];
+        }
+
+        return oy[PointCount - 1];
+    });
+
+    measure("rotate", "batch", PointCount, [&d, alpha]
+    {
+        rotate(d.pairs.data(), d.outPairs.data(), PointCount, alpha);
+        return d.outPairs[PointCount - 1].y();
+    });
+}
+
+// Circle overlap of one against all, as the collision prefilter
+void benchOverlap(Data &d)
+{
+    const int Probes = 64;
+
+    measure("overlap", "scalar", static_cast<long>(Probes) * PointCount, [&d, Probes]
+    {
+        double count = 0;
+
+        for(int a = 0; a < Probes; ++a)
+        {
+            for(int b = 0; b < PointCount; ++b)
+            {
+                if ((d.pairs[a] - d.pairs[b]).abs() <= d.radii[a] + d.radii[b])
+                {
+                    count += 1;
+                }
+            }
+        }
+
+        return count;
+    });
+
+    measure("overlap", "inlined", static_cast<long>(Probes) * PointCount, [&d, Probes]
+    {
+        double count = 0;
+
+        for(int a = 0; a < Probes; ++a)
+        {
+            for(int b = 0; b < PointCount; ++b)
+            {
+                // Squared distance, no sqrt
+                Xy v = d.xys[a] - d.xys[b];
+                double r = d.radii[a] + d.radii[b];
+
+                if (v.x * v.x + v.y * v.y <= r * r)
+                {
+                    count += 1;
+                }
+            }
+        }
+
+        return count;
+    });
+
+    measure("overlap", "vectorised", static_cast<long>(Probes) * PointCount, [&d, Probes]
+    {
+        const double *xs = d.xs.data();
+        const double *ys = d.ys.data();
+        const double *rs = d.radii.data();
+        double count = 0;
+
+        for(int a = 0; a < Probes; ++a)
+        {
+            double ax = xs[a];
+            double ay = ys[a];
+            double ar = rs[a];
+            long hits = 0;
+
+            for(int b = 0; b < PointCount; ++b)
+            {
+                double dx = ax - xs[b];
+                double dy = ay - ys[b];
+                double r = ar + rs[b];
+                hits += dx * dx + dy * dy <= r * r;
+            }
+
+            count += hits;
+        }
+
+        return count;
+    });
+}
+
+// Toroidal wrap of positions, as Universe::wrap()
+void benchWrap(Data &d)
+{
+    const double cx = 700;
+    const double cy = 500;
+    const double k = 50;
+
+    measure("wrap", "scalar", PointCount, [&d, cx, cy, k]
+    {
+        for(int n = 0; n < PointCount; ++n)
+        {
+            PairXy pos = d.pairs[n];
+
+            if (pos.x() < -k) pos.setX(cx + k);
+            else if (pos.x() > cx + k) pos.setX(-k);
+
+            if (pos.y() < -k) pos.setY(cy + k);
+            else if (pos.y() > cy + k) pos.setY(-k);
+
+            d.outPairs[n] = pos;
+        }
+
+        return d.outPairs[PointCount - 1].x();
+    });
+
+    measure("wrap", "inlined", PointCount, [&d, cx, cy, k]
+    {
+        for(int n = 0; n < PointCount; ++n)
+        {
+            Xy pos = d.xys[n];
+
+            if (pos.x < -k) pos.x = cx + k;
+            else if (pos.x > cx + k) pos.x = -k;
+
+            if (pos.y < -k) pos.y = cy + k;
+            else if (pos.y > cy + k) pos.y = -k;
+
+            d.outXys[n] = pos;
+        }
+
+        return d.outXys[PointCount - 1].x;
+    });
+
+    measure("wrap", "vectorised", PointCount, [&d, cx, cy, k]
+    {
+        const double *xs = d.xs.data();
+        const double *ys = d.ys.data();
+        double *ox = d.outXs.data();
+        double *oy = d.outYs.data();
+
+        // Branch free selects
+        for(int n = 0; n < PointCount; ++n)
+        {
+            double x = xs[n];
+            double y = ys[n];
+            x = x < -k ? cx + k : (x > cx + k ? -k : x);
+            y = y < -k ? cy + k : (y > cy + k ? -k : y);
+            ox[n] = x;
+            oy[n] = y;
+        }
+
+        return ox[PointCount - 1];
+    });
+}
+
+//---------------------------------------------------------------------------
+// SIMD KERNELS
+//---------------------------------------------------------------------------
+using Game::Internal::EntityKind;
+using Game::Internal::OverlapMargin;
+using Game::Internal::SimdKernels;
+using Game::Internal::SimdLevel;
+using Game::Internal::WrapBounds;
+
+const int LevelCount = static_cast<int>(SimdLevel::Avx512) + 1;
+const double RotateAlpha = 0.3;
+const PairXy TransformOffset(123.25, -45.5);
+
+struct Motion
+{
+    std::vector<PairXy> pos;
+    std::vector<PairXy> vel;
+    std::vector<PairXy> next;
+    std::vector<PairXy> poly;
+    std::vector<Real> radius;
+    std::vector<Real> mass;
+    std::vector<EntityKind> kind;
+    std::vector<std::size_t> index;
+    std::vector<std::size_t> contacts;
+    WrapBounds bounds;
+
+    Motion()
+    {
+        std::srand(2);
+        bounds.extent = PairXy(800, 600);
+        bounds.kuiper = PairXy(160, 120);
+        bounds.deepKinds = 0x1FE; // All but Ship
+
+        for(int n = 0; n < PointCount; ++n)
+        {
+            // Spread beyond the kuiper zone, so that many wrap
+            double x = -300.0 + 1400.0 * std::rand() / RAND_MAX;
+            double y = -300.0 + 1200.0 * std::rand() / RAND_MAX;
+            double r = (n % 7 == 0) ? 0 : 30.0 * std::rand() / RAND_MAX;
+
+            pos.push_back(PairXy(x, y));
+            vel.push_back(PairXy());
+            next.push_back(PairXy(-5.0 + 10.0 * std::rand() / RAND_MAX, -5.0 + 10.0 * std::rand() / RAND_MAX));
+            poly.push_back(PairXy(-50.0 + 100.0 * std::rand() / RAND_MAX, -50.0 + 100.0 * std::rand() / RAND_MAX));
+            radius.push_back(r);
+            mass.push_back((n % 5 == 0) ? 0 : r * r);
+            kind.push_back(static_cast<EntityKind>(n % 9));
+
+            // Odd count of neighbours, as given by the spatial grid
+            if (n % 3 != 0)
+            {
+                index.push_back(n);
+            }
+        }
+
+        // Edge cases: NaN, exactly on each bound, just beyond, and -0
+        pos[1] = PairXy(true);
+        pos[2] = PairXy(-radius[2], 600 + radius[2]);
+        pos[3] = PairXy(std::nextafter(-radius[3], -1e9), std::nextafter(600 + radius[3], 1e9));
+        pos[4] = PairXy(-0.0, 600);
+        pos[7] = PairXy(801, -1);
+        next[5] = PairXy(true);
+
+        // Polygon breaks, and points with one NaN component
+        poly[3] = PairXy(true);
+        poly[8] = PairXy(std::numeric_limits<double>::quiet_NaN(), 1);
+        poly[13] = PairXy(1, std::numeric_limits<double>::quiet_NaN());
+        poly[14] = PairXy(-0.0, 0);
+
+        contacts.resize(index.size());
+    }
+};
+
+// Per-entity logic of Universe::advance() prior to the kernels
+void referenceIntegrate(Motion &m)
+{
+    for(std::size_t n = 0; n < m.pos.size(); ++n)
+    {
+        m.vel[n] = m.next[n];
+        m.pos[n] += m.vel[n];
+    }
+}
+
+void referenceWrap(Motion &m)
+{
+    Real cx = m.bounds.extent.x();
+    Real cy = m.bounds.extent.y();
+
+    for(std::size_t n = 0; n < m.pos.size(); ++n)
+    {
+        PairXy &pos = m.pos[n];
+        bool deep = (m.bounds.deepKinds >> static_cast<int>(m.kind[n])) & 1;
+        Real kx = deep ? m.bounds.kuiper.x() : m.radius[n];
+        Real ky = deep ? m.bounds.kuiper.y() : m.radius[n];
+
+        if (pos.x() < -kx) pos.setX(cx + kx);
+        else if (pos.x() > cx + kx) pos.setX(-kx);
+
+        if (pos.y() < -ky) pos.setY(cy + ky);
+        else if (pos.y() > cy + ky) pos.setY(-ky);
+    }
+}
+
+// Contact prefilter of Universe::crunch(), as the kernel
+std::size_t referenceOverlap(Motion &m, std::size_t self)
+{
+    std::size_t hits = 0;
+
+    for(std::size_t n = 0; n < m.index.size(); ++n)
+    {
+        std::size_t y = m.index[n];
+        double r = m.radius[self] + m.radius[y];
+
+        if (m.mass[y] > 0 && (m.pos[self] - m.pos[y]).absSquared() <= r * r * OverlapMargin)
+        {
+            m.contacts[hits++] = y;
+        }
+    }
+
+    return hits;
+}
+
+template <typename T>
+bool sameBits(const std::vector<T> &a, const std::vector<T> &b)
+{
+    return std::memcmp(a.data(), b.data(), a.size() * sizeof(T)) == 0;
+}
+
+// Returns the sum of contacts for a spread of slots
+std::size_t overlapAll(const SimdKernels &k, Motion &m, std::vector<std::size_t> *all)
+{
+    std::size_t total = 0;
+
+    for(std::size_t self = 0; self < m.pos.size(); self += 16)
+    {
+        std::size_t hits = k.overlap(m.pos.data(), m.radius.data(), m.mass.data(),
+            self, m.index.data(), m.index.size(), m.contacts.data());
+        total += hits;
+
+        if (all != nullptr)
+        {
+            all->insert(all->end(), m.contacts.begin(), m.contacts.begin() + hits);
+        }
+    }
+
+    return total;
+}
+
+// Returns false if any level differs from the reference
+bool benchKernels()
+{
+    bool exact = true;
+    Motion ref;
+    std::vector<PairXy> refPoly(ref.poly.size());
+    std::vector<std::size_t> refContacts;
+
+    Game::rotate(ref.poly.data(), refPoly.data(), ref.poly.size(), RotateAlpha);
+    Game::translate(refPoly.data(), refPoly.data(), refPoly.size(), TransformOffset);
+
+    for(std::size_t self = 0; self < ref.pos.size(); self += 16)
+    {
+        std::size_t hits = referenceOverlap(ref, self);
+        refContacts.insert(refContacts.end(), ref.contacts.begin(), ref.contacts.begin() + hits);
+    }
+
+    referenceIntegrate(ref);
+    referenceWrap(ref);
+
+    std::printf("Detected: %s\n", Game::Internal::simdName(Game::Internal::simdDetected()));
+
+    for(int k = 0; k < LevelCount; ++k)
+    {
+        SimdLevel level = static_cast<SimdLevel>(k);
+        const char *name = Game::Internal::simdName(level);
+
+        if (!Game::Internal::simdSupported(level))
+        {
+            std::printf("%-10s %-11s not supported\n", "kernels", name);
+            continue;
+        }
+
+        const SimdKernels &ks = Game::Internal::kernels(level);
+        Motion m;
+        Real cs = Game::cosine<Real>(RotateAlpha);
+        Real sn = Game::sine<Real>(RotateAlpha);
+        std::vector<PairXy> poly(m.poly.size());
+        std::vector<std::size_t> contacts;
+
+        // Overlap first, as integrate and wrap move positions
+        overlapAll(ks, m, &contacts);
+        ks.transform(m.poly.data(), poly.data(), m.poly.size(), cs, sn, TransformOffset);
+        ks.integrate(m.pos.data(), m.vel.data(), m.next.data(), m.pos.size());
+        ks.wrap(m.pos.data(), m.radius.data(), m.kind.data(), m.pos.size(), m.bounds);
+
+        bool same = sameBits(m.pos, ref.pos) && sameBits(m.vel, ref.vel)
+            && sameBits(poly, refPoly) && contacts == refContacts;
+        exact = exact && same;
+        std::printf("%-10s %-11s %s\n", "kernels", name, same ? "exact" : "MISMATCH");
+
+        // Transform and overlap first, as integrate and wrap move positions
+        measure("transform", name, PointCount, [&m, &ks, &poly, cs, sn]
+        {
+            ks.transform(m.poly.data(), poly.data(), m.poly.size(), cs, sn, TransformOffset);
+            return poly[PointCount / 2].x();
+        });
+
+        long pairs = static_cast<long>((m.pos.size() + 15) / 16 * m.index.size());
+
+        measure("overlap", name, pairs, [&m, &ks]
+        {
+            return static_cast<double>(overlapAll(ks, m, nullptr));
+        });
+
+        measure("integrate", name, PointCount, [&m, &ks]
+        {
+            ks.integrate(m.pos.data(), m.vel.data(), m.next.data(), m.pos.size());
+            return m.pos[PointCount / 2].x();
+        });
+
+        measure("wrap", name, PointCount, [&m, &ks]
+        {
+            ks.wrap(m.pos.data(), m.radius.data(), m.kind.data(), m.pos.size(), m.bounds);
+            return m.pos[PointCount / 2].x();
+        });
+    }
+
+    return exact;
+}
+
+} // namespace
+
+int main()
+{
+    Data data;
+
+    std::printf("Points: %d\n", PointCount);
+
+    benchArith(data);
+    benchAbs(data);
+    benchThrottle(data);
+    benchRotate(data);
+    benchOverlap(data);
+    benchWrap(data);
+
+    return benchKernels() ? 0 : 1;
+}
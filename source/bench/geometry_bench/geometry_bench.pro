@@ -0,0 +1,22 @@
+#-------------------------------------------------
+# GEOMETRY MICROBENCHMARK
+#-------------------------------------------------
+# Console program comparing scalar, inlined and
+# vectorised variants of the PairXy and geometry
+# kernels. Build in release mode.
+
+TARGET = "geometry_bench"
+TEMPLATE = app
+CONFIG *= console
+CONFIG -= qt app_bundle
+
+include(../../common.pri)
+include(../../game/game.pri)
+
+DESTDIR = $$OUT_PWD/bin
+
+# Allow loop vectorisation at -O2 (GCC before 12)
+!msvc: QMAKE_CXXFLAGS_RELEASE *= -ftree-vectorize
+
+SOURCES += \
+    geometry_bench.cpp
@@ -0,0 +1,443 @@
+//---------------------------------------------------------------------------
+// PROJECT      : Asteroid Style Game
+// COPYRIGHT    : Andy Thomas (C) 2019
+// WEB URL      : https://kuiper.zone
+// LICENSE      : GPLv3
+//---------------------------------------------------------------------------
+
+// Scenario driven benchmark of Universe::advance() and draw(). Each scenario
+// file describes an initial population and spawn settings, and may give a
+// sweep of population sizes. For each run, the universe is populated and
+// advanced for a number of ticks, and one CSV row is written with the mean
+// time per tick of each phase, entities drawn and culled, heap allocations
+// and peak memory. With record, draw() is made to a RecordingCanvas, which
+// is then replayed to the NullCanvas, so that replay_ns is the time to
+// replay the display list of each frame.
+//
+// Scenario files hold "key = value" lines, where '#' starts a comment:
+//
+//   name           Name written to the CSV (default: file name)
+//   seed           Random seed (default 1)
+//   ticks          Measured ticks per run (default 500)
+//   warmup         Unmeasured ticks before measuring (default 50)
+//   size           Canvas size as WxH (default 1280x720)
+//   threads        Collision threads (default 1)
+//   simd           Kernel level, e.g. "sse2" or "avx2" (default: detected,
+//                  or ASTEROID_SIMD). Reduced to that detected if greater.
+//   draw           1 to call draw() every tick (default 1)
+//   record         1 to record draw() and replay it (default 0)
+//   ship           1 to add the player ship, which UFOs target (default 0)
+//   <EntityKind>   Initial count of a kind, e.g. "BigRock = 20". Ship and
+//                  Label are not accepted. With sweep, these are weights.
+//   sweep          Comma separated total populations, e.g. "100, 1000".
+//                  Kind counts are scaled in proportion for each run.
+//   startRocks, maxRockSpeed, maxUfoCount, rockPerSecond, ufoPerSecond
+//                  Universe::Settings values (defaults are those of the game)
+
+#include "../../headless/peak_memory.h"
+
+#include "game/null_canvas.h"
+#include "game/recording_canvas.h"
+#include "game/internal/universe.h"
+#include "game/internal/scaled_canvas.h"
+#include "game/internal/game_entity.h"
+#include "game/internal/ufo.h"
+
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <new>
+#include <string>
+#include <vector>
+
+using namespace Game;
+using namespace Game::Internal;
+
+//---------------------------------------------------------------------------
+// Heap allocation counter. Replaces the global allocation functions.
+//---------------------------------------------------------------------------
+namespace {
+std::atomic<std::int64_t> allocCount {0};
+}
+
+void* operator new(std::size_t size)
+{
+    allocCount.fetch_add(1, std::memory_order_relaxed);
+    void *ptr = std::malloc(size > 0 ? size : 1);
+
+    if (ptr == nullptr)
+    {
+        std::abort();
+    }
+
+    return ptr;
+}
+
+void* operator new[](std::size_t size)
+{
+    return operator new(size);
+}
+
+void operator delete(void *ptr) noexcept
+{
+    std::free(ptr);
+}
+
+void operator delete[](void *ptr) noexcept
+{
+    std::free(ptr);
+}
+
+void operator delete(void *ptr, std::size_t) noexcept
+{
+    std::free(ptr);
+}
+
+void operator delete[](void *ptr, std::size_t) noexcept
+{
+    std::free(ptr);
+}
+
+namespace {
+
+const int KindCount = static_cast<int>(EntityKind::Label) + 1;
+
+const char* const KindNames[KindCount] =
+    {"Ship", "BigRock", "MediumRock", "SmallRock", "Bullet", "Debris", "Spark", "Ufo", "Label"};
+
+struct Scenario
+{
+    std::string name;
+    std::uint64_t seed {1};
+    int ticks {500};
+    int warmup {50};
+    double width {1280};
+    double height {720};
+    int threads {1};
+    SimdLevel simd {simdDefault()};
+    bool draw {true};
+    bool record {false};
+    bool ship {false};
+    double kinds[KindCount] {};
+    std::vector<double> sweep;
+    Universe::Settings settings;
+};
+
+// Totals over the measured ticks of one run
+struct Result
+{
+    std::int64_t population {0};
+    SimdLevel simd {SimdLevel::Scalar};
+    std::int64_t finalCount {0};
+    std::int64_t crunchNs {0};
+    std::int64_t integrateNs {0};
+    std::int64_t behaviourNs {0};
+    std::int64_t wrapNs {0};
+    std::int64_t spawnNs {0};
+    std::int64_t advanceNs {0};
+    std::int64_t drawNs {0};
+    std::int64_t replayNs {0};
+    std::int64_t drawn {0};
+    std::int64_t culled {0};
+    std::int64_t pairsTested {0};
+    std::int64_t arenaAllocs {0};
+    std::int64_t allocs {0};
+};
+
+std::string trim(const std::string &s)
+{
+    std::size_t a = s.find_first_not_of(" \t\r\n");
+    std::size_t b = s.find_last_not_of(" \t\r\n");
+    return a == std::string::npos ? std::string() : s.substr(a, b - a + 1);
+}
+
+bool parseLine(Scenario &sc, const std::string &key, const std::string &value)
+{
+    const char *v = value.c_str();
+
+    if (key == "name") sc.name = value;
+    else if (key == "seed") sc.seed = std::strtoull(v, nullptr, 10);
+    else if (key == "ticks") sc.ticks = std::atoi(v);
+    else if (key == "warmup") sc.warmup = std::atoi(v);
+    else if (key == "threads") sc.threads = std::atoi(v);
+    else if (key == "simd") return simdParse(value, sc.simd);
+    else if (key == "draw") sc.draw = std::atoi(v) != 0;
+    else if (key == "record") sc.record = std::atoi(v) != 0;
+    else if (key == "ship") sc.ship = std::atoi(v) != 0;
+    else if (key == "startRocks") sc.settings.startRocks = std::atoi(v);
+    else if (key == "maxRockSpeed") sc.settings.maxRockSpeed = std::atof(v);
+    else if (key == "maxUfoCount") sc.settings.maxUfoCount = std::atoi(v);
+    else if (key == "rockPerSecond") sc.settings.maxRockPerSecond = std::atof(v);
+    else if (key == "ufoPerSecond") sc.settings.maxUfoPerSecond = std::atof(v);
+    else if (key == "size") return std::sscanf(v, "%lfx%lf", &sc.width, &sc.height) == 2;
+    else if (key == "sweep")
+    {
+        sc.sweep.clear();
+        std::string item;
+
+        for(std::size_t n = 0; n <= value.size(); ++n)
+        {
+            if (n == value.size() || value[n] == ',')
+            {
+                if (!trim(item).empty())
+                {
+                    sc.sweep.push_back(std::atof(item.c_str()));
+                }
+
+                item.clear();
+            }
+            else
+            {
+                item += value[n];
+            }
+        }
+    }
+    else
+    {
+        for(int k = 0; k < KindCount; ++k)
+        {
+            if (key == KindNames[k] && k != static_cast<int>(EntityKind::Ship)
+                && k != static_cast<int>(EntityKind::Label))
+            {
+                sc.kinds[k] = std::atof(v);
+                return true;
+            }
+        }
+
+        return false;
+    }
+
+    return true;
+}
+
+bool loadScenario(const std::string &path, Scenario &sc)
+{
+    std::FILE *file = std::fopen(path.c_str(), "r");
+
+    if (file == nullptr)
+    {
+        std::fprintf(stderr, "Cannot open: %s\n", path.c_str());
+        return false;
+    }
+
+    // Default name from file
+    sc.name = path.substr(path.find_last_of("/\\") + 1);
+    sc.name = sc.name.substr(0, sc.name.find('.'));
+
+    char buffer[1024];
+    int lineNum = 0;
+    bool ok = true;
+
+    while(ok && std::fgets(buffer, sizeof(buffer), file) != nullptr)
+    {
+        lineNum += 1;
+        std::string line = buffer;
+        line = trim(line.substr(0, line.find('#')));
+
+        if (!line.empty())
+        {
+            std::size_t eq = line.find('=');
+            ok = eq != std::string::npos
+                && parseLine(sc, trim(line.substr(0, eq)), trim(line.substr(eq + 1)));
+
+            if (!ok)
+            {
+                std::fprintf(stderr, "%s:%d: invalid line: %s\n", path.c_str(), lineNum, line.c_str());
+            }
+        }
+    }
+
+    std::fclose(file);
+    return ok && sc.ticks > 0 && sc.threads > 0;
+}
+
+void populate(Universe &u, const Scenario &sc, double total)
+{
+    double sum = 0;
+
+    for(int k = 0; k < KindCount; ++k)
+    {
+        sum += sc.kinds[k];
+    }
+
+    double scale = total > 0 && sum > 0 ? total / sum : 1;
+    double cx = u.canvas()->width();
+    double cy = u.canvas()->height();
+    double speed = sc.settings.maxRockSpeed * 0.2;
+
+    for(int k = 0; k < KindCount; ++k)
+    {
+        EntityKind kind = static_cast<EntityKind>(k);
+        long count = static_cast<long>(sc.kinds[k] * scale + 0.5);
+
+        for(long n = 0; n < count; ++n)
+        {
+            GameEntity *e = kind == EntityKind::Ufo ? new (&u) Ufo(&u) : u.create(kind);
+            PairXy pos(u.random(0, cx), u.random(0, cy));
+            PairXy vel(u.random(-speed, speed), u.random(-speed, speed));
+            u.add(e, pos)->setVelocity(vel);
+        }
+    }
+
+    if (sc.ship)
+    {
+        u.addShip();
+    }
+}
+
+std::int64_t nanosSince(std::chrono::steady_clock::time_point t0)
+{
+    auto d = std::chrono::steady_clock::now() - t0;
+    return static_cast<std::int64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(d).count());
+}
+
+Result run(const Scenario &sc, double total)
+{
+    Result res;
+    NullCanvas canvas(sc.width, sc.height);
+    RecordingCanvas recorder(sc.width, sc.height);
+    CanvasInterface *device = &canvas;
+
+    if (sc.record)
+    {
+        device = &recorder;
+    }
+
+    Universe u(new ScaledCanvas(device), sc.seed);
+
+    u.setSettings(sc.settings);
+    u.setThreadCount(sc.threads);
+    u.setSimdLevel(sc.simd);
+    populate(u, sc, total);
+    res.population = static_cast<std::int64_t>(u.store().size());
+    res.simd = u.simdLevel();
+
+    for(int n = 0; n < sc.warmup; ++n)
+    {
+        u.advance();
+
+        if (sc.draw)
+        {
+            u.draw();
+        }
+
+        if (sc.record)
+        {
+            recorder.replay(&canvas);
+            recorder.clear();
+        }
+    }
+
+    u.setProfiling(true);
+    std::int64_t allocs0 = allocCount.load();
+
+    for(int n = 0; n < sc.ticks; ++n)
+    {
+        auto t0 = std::chrono::steady_clock::now();
+        u.advance();
+        res.advanceNs += nanosSince(t0);
+
+        if (sc.draw)
+        {
+            t0 = std::chrono::steady_clock::now();
+            u.draw();
+            res.drawNs += nanosSince(t0);
+            res.drawn += u.drawStats().drawn;
+            res.culled += u.drawStats().culled;
+        }
+
+        if (sc.record)
+        {
+            t0 = std::chrono::steady_clock::now();
+            recorder.replay(&canvas);
+            recorder.clear();
+            res.replayNs += nanosSince(t0);
+        }
+
+        const Universe::TickStats &ts = u.tickStats();
+        res.crunchNs += ts.crunchNs;
+        res.integrateNs += ts.integrateNs;
+        res.behaviourNs += ts.behaviourNs;
+        res.wrapNs += ts.wrapNs;
+        res.spawnNs += ts.spawnNs;
+        res.pairsTested += ts.pairsTested;
+        res.arenaAllocs += ts.heapAllocs;
+    }
+
+    res.allocs = allocCount.load() - allocs0;
+    res.finalCount = static_cast<std::int64_t>(u.store().size());
+    return res;
+}
+
+void printHeader()
+{
+    std::printf("scenario,population,final,ticks,threads,simd,"
+        "crunch_ns,integrate_ns,behaviour_ns,wrap_ns,spawn_ns,advance_ns,draw_ns,"
+        "replay_ns,drawn_per_tick,culled_per_tick,pairs_per_tick,allocs_per_tick,arena_allocs,peak_rss_mb\n");
+}
+
+void printRow(const Scenario &sc, const Result &res)
+{
+    double t = sc.ticks;
+
+    std::printf("%s,%lld,%lld,%d,%d,%s,%.0f,%.0f,%.0f,%.0f,%.0f,%.0f,%.0f,%.0f,%.1f,%.1f,%.1f,%.3f,%lld,%.1f\n",
+        sc.name.c_str(), static_cast<long long>(res.population),
+        static_cast<long long>(res.finalCount), sc.ticks, sc.threads,
+        simdName(res.simd),
+        res.crunchNs / t, res.integrateNs / t, res.behaviourNs / t, res.wrapNs / t,
+        res.spawnNs / t, res.advanceNs / t, res.drawNs / t,
+        res.replayNs / t, res.drawn / t, res.culled / t,
+        res.pairsTested / t,
+        res.allocs / t, static_cast<long long>(res.arenaAllocs),
+        peakMemory() / (1024.0 * 1024.0));
+
+    std::fflush(stdout);
+}
+
+} // namespace
+
+int main(int argc, char *argv[])
+{
+    if (argc < 2 || std::strcmp(argv[1], "--help") == 0)
+    {
+        std::fprintf(stderr, "Usage: macro_bench scenario_file...\n"
+            "Writes CSV to stdout. See scenarios directory for examples.\n");
+        return argc < 2 ? 1 : 0;
+    }
+
+    std::vector<Scenario> list;
+
+    for(int n = 1; n < argc; ++n)
+    {
+        list.push_back(Scenario());
+
+        if (!loadScenario(argv[n], list.back()))
+        {
+            return 1;
+        }
+    }
+
+    printHeader();
+
+    for(std::size_t n = 0; n < list.size(); ++n)
+    {
+        const Scenario &sc = list[n];
+
+        if (sc.sweep.empty())
+        {
+            printRow(sc, run(sc, 0));
+        }
+
+        // Note peak RSS is that of the process so far. Sweeps
+        // should ascend, so that it reflects the current run.
+        for(std::size_t s = 0; s < sc.sweep.size(); ++s)
+        {
+            std::fprintf(stderr, "%s: %.0f\n", sc.name.c_str(), sc.sweep[s]);
+            printRow(sc, run(sc, sc.sweep[s]));
+        }
+    }
+
+    return 0;
+}
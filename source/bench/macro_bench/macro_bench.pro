@@ -0,0 +1,33 @@
+#-------------------------------------------------
+# MACRO BENCHMARK
+#-------------------------------------------------
+# Console program which runs Universe::advance() and
+# draw() against scenario files, and writes CSV of
+# time per tick of each phase, allocations and peak
+# memory. Example: macro_bench scenarios/*.txt
+
+TARGET = "macro_bench"
+TEMPLATE = app
+CONFIG *= console
+CONFIG -= qt app_bundle
+
+include(../../common.pri)
+include(../../game/game.pri)
+
+DESTDIR = $$OUT_PWD/bin
+
+win32: LIBS += -lpsapi
+
+HEADERS += \
+    ../../headless/peak_memory.h
+
+SOURCES += \
+    macro_bench.cpp \
+    ../../headless/peak_memory.cpp
+
+DISTFILES += \
+    scenarios/debris.txt \
+    scenarios/game.txt \
+    scenarios/record.txt \
+    scenarios/rocks.txt \
+    scenarios/ufos.txt
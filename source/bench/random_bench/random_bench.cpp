@@ -0,0 +1,94 @@
+//---------------------------------------------------------------------------
+// PROJECT      : Asteroid Style Game
+// COPYRIGHT    : Andy Thomas (C) 2019
+// WEB URL      : https://kuiper.zone
+// LICENSE      : GPLv3
+//---------------------------------------------------------------------------
+
+#include "game/internal/random.h"
+
+#include <random>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+
+using namespace Game::Internal;
+
+namespace {
+
+// Prevents calls being optimised away
+volatile double sink = 0;
+
+// Runs func count times and returns the mean nanoseconds per call
+template <typename F>
+double measure(long count, F func)
+{
+    double sum = 0;
+    auto t0 = std::chrono::steady_clock::now();
+
+    for(long n = 0; n < count; ++n)
+    {
+        sum += func();
+    }
+
+    auto t1 = std::chrono::steady_clock::now();
+    sink = sum;
+
+    return std::chrono::duration<double, std::nano>(t1 - t0).count() / count;
+}
+
+void report(const char *name, double ns, double base)
+{
+    std::printf("%-34s %8.2f ns/call %8.1fx\n", name, ns, base / ns);
+}
+
+} // namespace
+
+int main(int argc, char *argv[])
+{
+    long count = 20000000;
+
+    if (argc > 1)
+    {
+        count = std::atol(argv[1]);
+    }
+
+    if (count <= 0)
+    {
+        std::fprintf(stderr, "Usage: random_bench [calls]\n");
+        return 1;
+    }
+
+    std::printf("Calls: %ld\n", count);
+
+    // Former Universe::random(min, max)
+    std::ranlux24 ranlux(1);
+    double base = measure(count, [&ranlux]
+    {
+        std::uniform_real_distribution<double> unif(-1.0, 1.0);
+        return unif(ranlux);
+    });
+
+    report("ranlux24 + uniform_real_dist", base, base);
+
+    std::mt19937_64 mt(1);
+    report("mt19937_64 + uniform_real_dist", measure(count, [&mt]
+    {
+        std::uniform_real_distribution<double> unif(-1.0, 1.0);
+        return unif(mt);
+    }), base);
+
+    Random rand(1);
+    report("Random::real()", measure(count, [&rand]
+    {
+        return rand.real(-1.0, 1.0);
+    }), base);
+
+    std::uint64_t counter = 0;
+    report("Random::hash() counter", measure(count, [&counter]
+    {
+        return Random::toReal(Random::hash(1 ^ Random::hash(++counter)));
+    }), base);
+
+    return 0;
+}
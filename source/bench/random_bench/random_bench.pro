@@ -0,0 +1,19 @@
+#-------------------------------------------------
+# PRNG MICROBENCHMARK
+#-------------------------------------------------
+# Console program comparing the game PRNG with the
+# std::ranlux24 path which it replaced. Build in
+# release mode and run from the command line.
+
+TARGET = "random_bench"
+TEMPLATE = app
+CONFIG *= console
+CONFIG -= qt app_bundle
+
+include(../../common.pri)
+include(../../game/game.pri)
+
+DESTDIR = $$OUT_PWD/bin
+
+SOURCES += \
+    random_bench.cpp
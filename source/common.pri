@@ -0,0 +1,32 @@
+#-------------------------------------------------
+# COMMON CONFIGURATION
+#-------------------------------------------------
+# Included by all projects in the tree.
+
+CONFIG *= c++11 stl exceptions_off thread
+
+# Objects and temp files.
+OBJECTS_DIR = $$OUT_PWD/tmp/obj
+
+# Single precision or fixed point entity state. See game/real.h.
+# Enable with: qmake CONFIG+=float_physics (or fixed_physics)
+float_physics: DEFINES *= GAME_REAL_FLOAT
+fixed_physics: DEFINES *= GAME_REAL_FIXED
+
+# Multiply-add must not be contracted into FMA, so that the SIMD kernels
+# give the same result at any level, and the fixed point build gives the
+# same result on any machine. GCC contracts by default for C++ wherever
+# the target has FMA, as do the AVX-512 kernels.
+!msvc: QMAKE_CXXFLAGS *= -ffp-contract=off
+
+# RELEASE vs DEBUG
+Debug:DEFINES *= DEBUG
+Release:DEFINES *= QT_NO_DEBUG_OUTPUT
+
+# FIXES
+# We want M_PI and other math defines.
+# Best to define it here rather than in files.
+DEFINES *= _USE_MATH_DEFINES
+
+# MS headers interfere with std::min() and std::max()
+DEFINES *= NOMINMAX
@@ -12,6 +12,7 @@
 #include "sound_id.h"
 
 #include <string>
+#include <cstddef>
 
 namespace Game {
 
@@ -77,6 +78,22 @@ public:
     //! without first calling beginDraw().
     virtual void drawLine(const PairXy &p1, const PairXy& p2) = 0;
 
+    //! Draws count points as a sequence of lines starting at points[0], where a
+    //! PairXy value for which isNaN() is true serves as a break in the sequence.
+    //! This allows an implementation to submit an entire outline in one batch.
+    //! The base implementation calls drawLine() for each line. It is an error
+    //! to call this method without first calling beginDraw().
+    virtual void drawPolyline(const PairXy *points, std::size_t count)
+    {
+        for(std::size_t n = 1; n < count; ++n)
+        {
+            if (!points[n - 1].isNaN() && !points[n].isNaN())
+            {
+                drawLine(points[n - 1], points[n]);
+            }
+        }
+    }
+
     //! Draws text at position pos. The text is to be aligned horizontally and
     //! vertically according to horz and vert respectively. The text string is
     //! not expected to contain new-line characters and the implementation need
@@ -87,6 +104,18 @@ public:
     virtual double drawText(const PairXy &pos, AlignHorz horz, AlignVert vert,
         double rem, const std::string &text)  = 0;
 
+    //! Returns the height of text in canvas units, as would be returned by
+    //! drawText() for the same rem and text, but without drawing. It may be
+    //! called at any time, and allows text to be laid out apart from drawing.
+    //! The base implementation returns 0, for canvases which cannot measure
+    //! text other than by drawing it.
+    virtual double textHeight(double rem, const std::string &text) const
+    {
+        (void)rem;
+        (void)text;
+        return 0;
+    }
+
     //! Asynchronously (non-blocking) plays the sound indicated by id. If audio
     //! is not supported, this method may be implemented such that it does nothing.
     virtual void playSound(SoundId id, SoundOpt opt) = 0;
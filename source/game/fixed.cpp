@@ -0,0 +1,109 @@
+//---------------------------------------------------------------------------
+// PROJECT      : Asteroid Style Game
+// COPYRIGHT    : Andy Thomas (C) 2019
+// WEB URL      : https://kuiper.zone
+// LICENSE      : GPLv3
+//---------------------------------------------------------------------------
+
+#include "fixed.h"
+
+#include <cmath>
+
+using namespace Game;
+
+namespace {
+
+// Table entries per turn (power of 2)
+const int TableSize = 4096;
+const double TwoPi = 6.283185307179586476925286766559;
+
+// Sine for one turn, plus one entry so that interpolation
+// need not wrap. Built on first use.
+struct SineTable
+{
+    std::int64_t raw[TableSize + 1];
+
+    SineTable()
+    {
+        // First quadrant by Taylor series, using basic arithmetic only,
+        // which is exact to IEEE 754 on all targets. The remaining
+        // quadrants follow by symmetry.
+        const int quarter = TableSize / 4;
+
+        for(int n = 0; n <= quarter; ++n)
+        {
+            double x = TwoPi * n / TableSize;
+            double term = x;
+            double sum = x;
+
+            for(int k = 1; k < 16; ++k)
+            {
+                term = -term * x * x / ((2 * k) * (2 * k + 1));
+                sum += term;
+            }
+
+            std::int64_t r = Fixed(sum).raw();
+            raw[n] = r;
+            raw[2 * quarter - n] = r;
+            raw[2 * quarter + n] = -r;
+            raw[TableSize - n] = -r;
+        }
+    }
+};
+
+// Interpolated sine, where turn is the angle in table units
+Fixed sineOf(double turn)
+{
+    static const SineTable table;
+
+    double whole = std::floor(turn);
+    std::int64_t frac = Fixed(turn - whole).raw();
+    int index = static_cast<int>(static_cast<std::int64_t>(whole) & (TableSize - 1));
+
+    std::int64_t a = table.raw[index];
+    std::int64_t b = table.raw[index + 1];
+    return Fixed::fromRaw(a + (((b - a) * frac) >> Fixed::FracBits));
+}
+
+} // namespace
+
+//---------------------------------------------------------------------------
+// CLASS Fixed : PUBLIC MEMBERS
+//---------------------------------------------------------------------------
+Fixed Fixed::sin(double alpha)
+{
+    return sineOf(alpha * (TableSize / TwoPi));
+}
+
+Fixed Fixed::cos(double alpha)
+{
+    return sineOf(alpha * (TableSize / TwoPi) + TableSize / 4);
+}
+
+//---------------------------------------------------------------------------
+// NON-CLASS FUNCTIONS
+//---------------------------------------------------------------------------
+Fixed Game::sqrt(Fixed value)
+{
+    if (value.raw() < 0 || value.isNaN())
+    {
+        return Fixed::nan();
+    }
+
+    // Raw result is the integer square root of raw value times One. The
+    // estimate from double is corrected, so the result is exact regardless.
+    std::uint64_t n = static_cast<std::uint64_t>(value.raw()) << Fixed::FracBits;
+    std::uint64_t r = static_cast<std::uint64_t>(std::sqrt(static_cast<double>(n)));
+
+    while(r > 0 && r * r > n)
+    {
+        r -= 1;
+    }
+
+    while((r + 1) * (r + 1) <= n)
+    {
+        r += 1;
+    }
+
+    return Fixed::fromRaw(static_cast<std::int64_t>(r));
+}
@@ -0,0 +1,234 @@
+//---------------------------------------------------------------------------
+// PROJECT      : Asteroid Style Game
+// COPYRIGHT    : Andy Thomas (C) 2019
+// WEB URL      : https://kuiper.zone
+// LICENSE      : GPLv3
+//---------------------------------------------------------------------------
+
+#ifndef GAME_FIXED_H
+#define GAME_FIXED_H
+
+#include <cmath>
+#include <cstdint>
+#include <limits>
+#include <type_traits>
+
+namespace Game {
+
+//! A signed fixed point number, held in 64 bits of which 16 are fractional.
+//! It gives a resolution of about 1.5e-5 and is intended for values whose
+//! products are less than 2^31 in magnitude, which is ample for game physics.
+//! Arithmetic is on integers only, so that results are identical on any
+//! machine and with any compiler options. It is used as Real in the fixed
+//! point build. See real.h.
+//!
+//! Fixed converts implicitly to and from arithmetic types, so that it can
+//! replace double with few changes. Mixed operations, such as Fixed + double,
+//! convert the other operand to Fixed and give a Fixed result. Conversion
+//! from double rounds to nearest and is exact for integers. Products round
+//! to nearest, with halves away from zero, so that negation commutes with
+//! multiplication.
+//!
+//! One value is reserved to represent NaN, as used for breaks in polygons.
+//! It converts to and from NaN, and is equal to no value, not even itself.
+//! Otherwise, arithmetic does not propagate it, so values should be checked
+//! with isNaN() where they may be NaN.
+class Fixed
+{
+    template <typename U, typename R>
+    using IfArithmetic = typename std::enable_if<std::is_arithmetic<U>::value, R>::type;
+
+public:
+
+    //! Number of fractional bits.
+    static const int FracBits = 16;
+
+    //! Raw value of 1.0.
+    static const std::int64_t One = std::int64_t(1) << FracBits;
+
+    //! Raw value of NaN.
+    static const std::int64_t NaNRaw = std::numeric_limits<std::int64_t>::min();
+
+    //! Default constructor. The value is 0.
+    constexpr Fixed() = default;
+
+    //! Conversion constructor.
+    template <typename U, typename = IfArithmetic<U, void>>
+    constexpr Fixed(U value)
+        : _raw{fromDouble(static_cast<double>(value))}
+    {
+    }
+
+    //! Returns an instance with the given raw value.
+    static constexpr Fixed fromRaw(std::int64_t raw)
+    {
+        return Fixed(raw, RawTag());
+    }
+
+    //! Returns the NaN value.
+    static constexpr Fixed nan()
+    {
+        return Fixed(NaNRaw, RawTag());
+    }
+
+    //! Returns the raw value, i.e. the value multiplied by One.
+    constexpr std::int64_t raw() const { return _raw; }
+
+    //! Returns true if the value is NaN.
+    constexpr bool isNaN() const { return _raw == NaNRaw; }
+
+    //! Conversion to double, which is exact.
+    constexpr operator double() const
+    {
+        return _raw != NaNRaw ? static_cast<double>(_raw) / One
+            : std::numeric_limits<double>::quiet_NaN();
+    }
+
+    //! Returns sine and cosine of alpha (radians). These are given by linear
+    //! interpolation in a table which is generated with basic arithmetic
+    //! only, so that results do not depend on the math library.
+    static Fixed sin(double alpha);
+    static Fixed cos(double alpha);
+
+    //! Negation.
+    constexpr Fixed operator-() const
+    {
+        return fromRaw(-_raw);
+    }
+
+    //! Compound assignment.
+    Fixed& operator+= (Fixed other)
+    {
+        _raw += other._raw;
+        return *this;
+    }
+
+    Fixed& operator-= (Fixed other)
+    {
+        _raw -= other._raw;
+        return *this;
+    }
+
+    Fixed& operator*= (Fixed other)
+    {
+        return *this = *this * other;
+    }
+
+    Fixed& operator/= (Fixed other)
+    {
+        return *this = *this / other;
+    }
+
+    //! Arithmetic operators. Division by zero gives the greatest
+    //! magnitude value of the sign of the dividend, rather than a fault.
+    friend constexpr Fixed operator+(Fixed a, Fixed b)
+    {
+        return fromRaw(a._raw + b._raw);
+    }
+
+    friend constexpr Fixed operator-(Fixed a, Fixed b)
+    {
+        return fromRaw(a._raw - b._raw);
+    }
+
+    friend constexpr Fixed operator*(Fixed a, Fixed b)
+    {
+        // Round to nearest, halves away from zero, so that -(a * b)
+        // equals -a * b exactly
+        return fromRaw(a._raw * b._raw >= 0 ? (a._raw * b._raw + One / 2) >> FracBits
+            : -((One / 2 - a._raw * b._raw) >> FracBits));
+    }
+
+    friend constexpr Fixed operator/(Fixed a, Fixed b)
+    {
+        return b._raw != 0 ? fromRaw(a._raw * One / b._raw)
+            : fromRaw(a._raw < 0 ? NaNRaw + 1 : -(NaNRaw + 1));
+    }
+
+    //! Comparison operators. Only == and != take account of NaN.
+    friend constexpr bool operator==(Fixed a, Fixed b)
+    {
+        return a._raw == b._raw && a._raw != NaNRaw;
+    }
+
+    friend constexpr bool operator!=(Fixed a, Fixed b)
+    {
+        return !(a == b);
+    }
+
+    friend constexpr bool operator<(Fixed a, Fixed b) { return a._raw < b._raw; }
+    friend constexpr bool operator<=(Fixed a, Fixed b) { return a._raw <= b._raw; }
+    friend constexpr bool operator>(Fixed a, Fixed b) { return a._raw > b._raw; }
+    friend constexpr bool operator>=(Fixed a, Fixed b) { return a._raw >= b._raw; }
+
+    //! Mixed operators. These take precedence over the built-in operators,
+    //! which would otherwise be ambiguous with those above.
+    template <typename U> friend constexpr IfArithmetic<U, Fixed> operator+(Fixed a, U b) { return a + Fixed(b); }
+    template <typename U> friend constexpr IfArithmetic<U, Fixed> operator+(U a, Fixed b) { return Fixed(a) + b; }
+    template <typename U> friend constexpr IfArithmetic<U, Fixed> operator-(Fixed a, U b) { return a - Fixed(b); }
+    template <typename U> friend constexpr IfArithmetic<U, Fixed> operator-(U a, Fixed b) { return Fixed(a) - b; }
+    template <typename U> friend constexpr IfArithmetic<U, Fixed> operator*(Fixed a, U b) { return a * Fixed(b); }
+    template <typename U> friend constexpr IfArithmetic<U, Fixed> operator*(U a, Fixed b) { return Fixed(a) * b; }
+    template <typename U> friend constexpr IfArithmetic<U, Fixed> operator/(Fixed a, U b) { return a / Fixed(b); }
+    template <typename U> friend constexpr IfArithmetic<U, Fixed> operator/(U a, Fixed b) { return Fixed(a) / b; }
+
+    template <typename U> friend constexpr IfArithmetic<U, bool> operator==(Fixed a, U b) { return a == Fixed(b); }
+    template <typename U> friend constexpr IfArithmetic<U, bool> operator==(U a, Fixed b) { return Fixed(a) == b; }
+    template <typename U> friend constexpr IfArithmetic<U, bool> operator!=(Fixed a, U b) { return a != Fixed(b); }
+    template <typename U> friend constexpr IfArithmetic<U, bool> operator!=(U a, Fixed b) { return Fixed(a) != b; }
+    template <typename U> friend constexpr IfArithmetic<U, bool> operator<(Fixed a, U b) { return a < Fixed(b); }
+    template <typename U> friend constexpr IfArithmetic<U, bool> operator<(U a, Fixed b) { return Fixed(a) < b; }
+    template <typename U> friend constexpr IfArithmetic<U, bool> operator<=(Fixed a, U b) { return a <= Fixed(b); }
+    template <typename U> friend constexpr IfArithmetic<U, bool> operator<=(U a, Fixed b) { return Fixed(a) <= b; }
+    template <typename U> friend constexpr IfArithmetic<U, bool> operator>(Fixed a, U b) { return a > Fixed(b); }
+    template <typename U> friend constexpr IfArithmetic<U, bool> operator>(U a, Fixed b) { return Fixed(a) > b; }
+    template <typename U> friend constexpr IfArithmetic<U, bool> operator>=(Fixed a, U b) { return a >= Fixed(b); }
+    template <typename U> friend constexpr IfArithmetic<U, bool> operator>=(U a, Fixed b) { return Fixed(a) >= b; }
+
+private:
+
+    struct RawTag {};
+
+    constexpr Fixed(std::int64_t raw, RawTag)
+        : _raw{raw}
+    {
+    }
+
+    static constexpr std::int64_t fromDouble(double value)
+    {
+        return value != value ? NaNRaw : static_cast<std::int64_t>(value * One + (value < 0 ? -0.5 : 0.5));
+    }
+
+    std::int64_t _raw {0};
+};
+
+//! Square root, on integers only. Found by argument dependent lookup, so that
+//! generic code should call "sqrt(x)" after "using std::sqrt". The result is
+//! NaN if value is negative or NaN.
+Fixed sqrt(Fixed value);
+
+} // namespace
+
+namespace std {
+
+//! Limits of Game::Fixed, so that it can be used where a type
+//! with NaN is expected, such as PairXy.
+template <>
+class numeric_limits<Game::Fixed>
+{
+public:
+    static const bool is_specialized = true;
+    static const bool is_signed = true;
+    static const bool is_integer = false;
+    static const bool is_exact = true;
+    static const bool has_quiet_NaN = true;
+
+    static constexpr Game::Fixed min() { return Game::Fixed::fromRaw(1); }
+    static constexpr Game::Fixed lowest() { return Game::Fixed::fromRaw(Game::Fixed::NaNRaw + 1); }
+    static constexpr Game::Fixed max() { return Game::Fixed::fromRaw(-(Game::Fixed::NaNRaw + 1)); }
+    static constexpr Game::Fixed epsilon() { return Game::Fixed::fromRaw(1); }
+    static constexpr Game::Fixed quiet_NaN() { return Game::Fixed::nan(); }
+};
+
+} // namespace
+#endif
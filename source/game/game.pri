@@ -0,0 +1,16 @@
+#-------------------------------------------------
+# GAME LIBRARY
+#-------------------------------------------------
+# Included by projects which link against the game
+# core library. The library project must be built
+# first (see "depends" in asteroid.pro).
+
+GAME_LIB_DIR = $$shadowed($$PWD)/lib
+
+INCLUDEPATH += $$PWD/..
+DEPENDPATH += $$PWD/..
+
+LIBS += -L$$GAME_LIB_DIR -lgame
+
+win32-msvc*: PRE_TARGETDEPS += $$GAME_LIB_DIR/game.lib
+else: PRE_TARGETDEPS += $$GAME_LIB_DIR/libgame.a
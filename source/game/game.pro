@@ -0,0 +1,85 @@
+#-------------------------------------------------
+# GAME CORE LIBRARY
+#-------------------------------------------------
+# The game core is plain C++ with no Qt dependency.
+# It is built as a static library, which is linked
+# by the application, headless runner and benchmarks
+# by including game.pri.
+
+TARGET = game
+TEMPLATE = lib
+CONFIG *= staticlib
+CONFIG -= qt
+
+include(../common.pri)
+
+DESTDIR = $$shadowed($$PWD)/lib
+INCLUDEPATH += $$PWD/..
+
+HEADERS += \
+    internal/big_rock.h \
+    internal/bullet.h \
+    internal/collision_mask.h \
+    internal/debris.h \
+    internal/entity_arena.h \
+    internal/entity_kind.h \
+    internal/entity_store.h \
+    internal/entity_visit.h \
+    internal/exploder.h \
+    internal/game_entity.h \
+    internal/label.h \
+    internal/medium_rock.h \
+    internal/narrowphase.h \
+    internal/random.h \
+    internal/rotator.h \
+    internal/scaled_canvas.h \
+    internal/shape_library.h \
+    internal/ship.h \
+    internal/simd.h \
+    internal/simd_kernels.h \
+    internal/small_rock.h \
+    internal/spark.h \
+    internal/spatial_grid.h \
+    internal/thread_pool.h \
+    internal/ufo.h \
+    internal/universe.h \
+    canvas_interface.h \
+    fixed.h \
+    input_log.h \
+    key_id.h \
+    null_canvas.h \
+    pair_span.h \
+    pair_xy.h \
+    player.h \
+    recording_canvas.h \
+    real.h \
+    sound_id.h
+
+SOURCES += \
+    internal/big_rock.cpp \
+    internal/bullet.cpp \
+    internal/debris.cpp \
+    internal/entity_arena.cpp \
+    internal/entity_store.cpp \
+    internal/exploder.cpp \
+    internal/game_entity.cpp \
+    internal/label.cpp \
+    internal/medium_rock.cpp \
+    internal/narrowphase.cpp \
+    internal/rotator.cpp \
+    internal/scaled_canvas.cpp \
+    internal/shape_library.cpp \
+    internal/ship.cpp \
+    internal/simd.cpp \
+    internal/simd_kernels.cpp \
+    internal/small_rock.cpp \
+    internal/spark.cpp \
+    internal/spatial_grid.cpp \
+    internal/thread_pool.cpp \
+    internal/ufo.cpp \
+    internal/universe.cpp \
+    fixed.cpp \
+    input_log.cpp \
+    null_canvas.cpp \
+    player.cpp \
+    recording_canvas.cpp
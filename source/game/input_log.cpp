@@ -0,0 +1,227 @@
+//---------------------------------------------------------------------------
+// PROJECT      : Asteroid Style Game
+// COPYRIGHT    : Andy Thomas (C) 2019
+// WEB URL      : https://kuiper.zone
+// LICENSE      : GPLv3
+//---------------------------------------------------------------------------
+
+#include "input_log.h"
+
+#include <cstdio>
+#include <cstring>
+
+using namespace Game;
+
+namespace {
+
+// File signature and format version
+const char Magic[4] = {'A', 'A', 'L', 'G'};
+const std::uint8_t Version = 1;
+
+void putVarint(std::vector<std::uint8_t> &dest, std::uint64_t value)
+{
+    while(value >= 0x80)
+    {
+        dest.push_back(static_cast<std::uint8_t>(value | 0x80));
+        value >>= 7;
+    }
+
+    dest.push_back(static_cast<std::uint8_t>(value));
+}
+
+bool getVarint(const std::vector<std::uint8_t> &src, std::size_t &pos, std::uint64_t &value)
+{
+    value = 0;
+
+    for(int shift = 0; shift < 64 && pos < src.size(); shift += 7)
+    {
+        std::uint8_t b = src[pos++];
+        value |= static_cast<std::uint64_t>(b & 0x7F) << shift;
+
+        if ((b & 0x80) == 0)
+        {
+            return true;
+        }
+    }
+
+    return false;
+}
+
+void putDouble(std::vector<std::uint8_t> &dest, double value)
+{
+    std::uint64_t bits;
+    std::memcpy(&bits, &value, sizeof(bits));
+
+    for(int n = 0; n < 8; ++n)
+    {
+        dest.push_back(static_cast<std::uint8_t>(bits >> (n * 8)));
+    }
+}
+
+bool getDouble(const std::vector<std::uint8_t> &src, std::size_t &pos, double &value)
+{
+    if (pos + 8 > src.size())
+    {
+        return false;
+    }
+
+    std::uint64_t bits = 0;
+
+    for(int n = 0; n < 8; ++n)
+    {
+        bits |= static_cast<std::uint64_t>(src[pos++]) << (n * 8);
+    }
+
+    std::memcpy(&value, &bits, sizeof(value));
+    return true;
+}
+
+} // namespace
+
+//---------------------------------------------------------------------------
+// CLASS InputLog : PUBLIC MEMBERS
+//---------------------------------------------------------------------------
+std::uint64_t InputLog::seed() const
+{
+    return _seed;
+}
+
+void InputLog::setSeed(std::uint64_t seed)
+{
+    _seed = seed;
+}
+
+std::size_t InputLog::size() const
+{
+    return _events.size();
+}
+
+const InputLog::Event& InputLog::at(std::size_t index) const
+{
+    return _events[index];
+}
+
+void InputLog::clear()
+{
+    _events.clear();
+}
+
+void InputLog::append(const Event &event)
+{
+    _events.push_back(event);
+}
+
+std::vector<std::uint8_t> InputLog::encode() const
+{
+    // Header: magic, version, seed, event count.
+    // Event: tick delta, then action in the high nibble and key in the
+    // low nibble, followed by dimensions for Resize only.
+    std::vector<std::uint8_t> data(Magic, Magic + sizeof(Magic));
+    data.push_back(Version);
+    putVarint(data, _seed);
+    putVarint(data, _events.size());
+
+    std::int64_t tick = 0;
+
+    for(std::size_t n = 0; n < _events.size(); ++n)
+    {
+        const Event &e = _events[n];
+        putVarint(data, static_cast<std::uint64_t>(e.tick - tick));
+        data.push_back(static_cast<std::uint8_t>((static_cast<int>(e.action) << 4) | static_cast<int>(e.key)));
+        tick = e.tick;
+
+        if (e.action == Action::Resize)
+        {
+            putDouble(data, e.width);
+            putDouble(data, e.height);
+        }
+    }
+
+    return data;
+}
+
+bool InputLog::decode(const std::vector<std::uint8_t> &data)
+{
+    _events.clear();
+
+    if (data.size() < sizeof(Magic) + 1 || std::memcmp(data.data(), Magic, sizeof(Magic)) != 0
+        || data[sizeof(Magic)] != Version)
+    {
+        return false;
+    }
+
+    std::size_t pos = sizeof(Magic) + 1;
+    std::uint64_t seed, count;
+
+    if (!getVarint(data, pos, seed) || !getVarint(data, pos, count))
+    {
+        return false;
+    }
+
+    std::int64_t tick = 0;
+
+    for(std::uint64_t n = 0; n < count; ++n)
+    {
+        std::uint64_t delta;
+
+        if (!getVarint(data, pos, delta) || pos >= data.size())
+        {
+            _events.clear();
+            return false;
+        }
+
+        int code = data[pos++];
+        tick += static_cast<std::int64_t>(delta);
+
+        Event e {tick, static_cast<Action>(code >> 4), static_cast<KeyId>(code & 0x0F), 0, 0};
+
+        if (e.action > Action::Resize || e.key > KeyId::Count || (e.action == Action::Resize
+            && (!getDouble(data, pos, e.width) || !getDouble(data, pos, e.height))))
+        {
+            _events.clear();
+            return false;
+        }
+
+        _events.push_back(e);
+    }
+
+    _seed = seed;
+    return true;
+}
+
+bool InputLog::save(const std::string &path) const
+{
+    std::FILE *file = std::fopen(path.c_str(), "wb");
+
+    if (file == nullptr)
+    {
+        return false;
+    }
+
+    std::vector<std::uint8_t> data = encode();
+    bool ok = std::fwrite(data.data(), 1, data.size(), file) == data.size();
+
+    return std::fclose(file) == 0 && ok;
+}
+
+bool InputLog::load(const std::string &path)
+{
+    std::FILE *file = std::fopen(path.c_str(), "rb");
+
+    if (file == nullptr)
+    {
+        return false;
+    }
+
+    std::vector<std::uint8_t> data;
+    std::uint8_t buffer[4096];
+    std::size_t count;
+
+    while((count = std::fread(buffer, 1, sizeof(buffer), file)) > 0)
+    {
+        data.insert(data.end(), buffer, buffer + count);
+    }
+
+    std::fclose(file);
+    return decode(data);
+}
@@ -0,0 +1,91 @@
+//---------------------------------------------------------------------------
+// PROJECT      : Asteroid Style Game
+// COPYRIGHT    : Andy Thomas (C) 2019
+// WEB URL      : https://kuiper.zone
+// LICENSE      : GPLv3
+//---------------------------------------------------------------------------
+
+#ifndef GAME_INPUT_LOG_H
+#define GAME_INPUT_LOG_H
+
+#include "key_id.h"
+
+#include <vector>
+#include <string>
+#include <cstdint>
+
+namespace Game {
+
+//! Holds a record of the input given to a Player instance, together with the
+//! seed with which it was constructed. Each event is stamped with the number of
+//! Player::advance() calls made before it occurred. Given the log, a Player can
+//! reproduce a game exactly, tick for tick. See Player::record() and replay().
+//! The log can be saved to and loaded from a file in a compact binary form,
+//! where each key event occupies 2 bytes typically.
+class InputLog
+{
+public:
+
+    //! Event type.
+    enum class Action : std::uint8_t
+    {
+        KeyUp, //!< Key raised.
+        KeyDown, //!< Key pressed.
+        Start, //!< Player::startGame() called.
+        Resize, //!< Canvas dimensions changed.
+    };
+
+    //! Input event.
+    struct Event
+    {
+        //! Number of Player::advance() calls prior to event.
+        std::int64_t tick;
+
+        //! Event type.
+        Action action;
+
+        //! Key for KeyUp and KeyDown, otherwise KeyId::Count.
+        KeyId key;
+
+        //! Canvas dimensions for Resize, otherwise 0.
+        double width;
+        double height;
+    };
+
+    //! Gets and sets the seed.
+    std::uint64_t seed() const;
+    void setSeed(std::uint64_t seed);
+
+    //! Returns the number of events.
+    std::size_t size() const;
+
+    //! Returns the event at index, where index must be less than size().
+    const Event& at(std::size_t index) const;
+
+    //! Removes all events. The seed is not changed.
+    void clear();
+
+    //! Appends an event. The tick may not be less than that of the last event.
+    void append(const Event &event);
+
+    //! Encodes the log to a byte sequence.
+    std::vector<std::uint8_t> encode() const;
+
+    //! Decodes the log from a byte sequence given by encode(). The result is
+    //! false if data is not valid, in which case the log is left empty.
+    bool decode(const std::vector<std::uint8_t> &data);
+
+    //! Writes the log to a binary file. The result is false on failure.
+    bool save(const std::string &path) const;
+
+    //! Reads the log from a binary file. The result is false on failure.
+    bool load(const std::string &path);
+
+private:
+
+    std::uint64_t _seed {0};
+    std::vector<Event> _events;
+};
+
+} // namespace
+#endif
@@ -16,9 +16,9 @@ using namespace Game::Internal;
 // CLASS BigRock : PUBLIC MEMBERS
 //---------------------------------------------------------------------------
 BigRock::BigRock(Universe *owner)
-    : Rotator(owner)
+    : Rotator(owner, EntityKind::BigRock)
 {
-    setPolygon(30.0);
+    setShape();
     setFragility(0.5);
     setFragmentKind(EntityKind::MediumRock);
     setFragmentCount(2);
@@ -14,16 +14,11 @@ namespace Game { namespace Internal {
 
 //! A concrete big rock class. Derived from Rotator and fragments into
 //! medium rocks when it explodes.
-class BigRock : public Rotator
+class BigRock final : public Rotator
 {
 public:
 
     BigRock(Universe *owner);
-
-    // Overrides
-    EntityKind kind() const override { return EntityKind::BigRock; }
-    int score() const override { return 100; }
-    double mass() const override { return 300; }
 };
 
 }} // namespace
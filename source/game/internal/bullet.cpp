@@ -15,7 +15,7 @@ using namespace Game::Internal;
 // CLASS Bullet : PUBLIC MEMBERS
 //---------------------------------------------------------------------------
 Bullet::Bullet(Universe *owner, const PairXy& vel)
-    : GameEntity(owner)
+    : GameEntity(owner, EntityKind::Bullet)
 {
     setVelocity(vel);
 
@@ -36,17 +36,6 @@ Bullet::Bullet(Universe *owner, const PairXy& vel)
     }
 }
 
-bool Bullet::crunch(GameEntity *other)
-{
-    if (GameEntity::crunch(other))
-    {
-        _hit = true;
-        return true;
-    }
-
-    return false;
-}
-
 bool Bullet::advance()
 {
     if (_hit)
@@ -60,18 +49,18 @@ bool Bullet::advance()
 void Bullet::draw()
 {
     // Draw in same direction as motion.
-    static const double Radius = 1.0;
-
     PairXy dv = velocity();
     double va = dv.abs();
 
     if (va > 0)
     {
-        dv /= va * Radius;
+        dv /= va * DrawRadius;
     }
     else
     {
-        dv = PairXy(owner()->random(-Radius, Radius), owner()->random(-Radius, Radius));
+        // Cosmetic, so as not to advance the play stream
+        dv = PairXy(owner()->shapeRandom(-DrawRadius, DrawRadius),
+            owner()->shapeRandom(-DrawRadius, DrawRadius));
     }
 
     owner()->canvas()->drawLine(position() - dv, position() + dv);
@@ -14,21 +14,24 @@ namespace Game { namespace Internal {
 
 //! A bullet fired from the Ship class. The constructor should be used to
 //! set the velocity.
-class Bullet : public GameEntity
+class Bullet final : public GameEntity
 {
 public:
 
     Bullet(Universe *owner, const PairXy& vel = PairXy());
 
-    // Overrides
-    EntityKind kind() const override { return EntityKind::Bullet; }
-    double mass() const override { return 1.0; }
-    virtual bool crunch(GameEntity *other) override;
-    virtual bool advance() override;
-    void draw() override;
+    // Hides GameEntity
+    double extent() const { return DrawRadius; }
+    bool advance();
+    void draw();
 
 private:
 
+    friend class Narrowphase;
+
+    // Half length of the line drawn
+    static constexpr double DrawRadius = 1.0;
+
     bool _hit {false};
 };
 
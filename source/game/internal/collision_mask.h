@@ -0,0 +1,69 @@
+//---------------------------------------------------------------------------
+// PROJECT      : Asteroid Style Game
+// COPYRIGHT    : Andy Thomas (C) 2019
+// WEB URL      : https://kuiper.zone
+// LICENSE      : GPLv3
+//---------------------------------------------------------------------------
+
+#ifndef GAME_COLLISION_MASK_H
+#define GAME_COLLISION_MASK_H
+
+#include "entity_kind.h"
+
+#include <cstdint>
+
+namespace Game { namespace Internal {
+
+//! Returns the bit of kind in a mask of kinds.
+inline constexpr std::uint32_t kindBit(EntityKind kind)
+{
+    return 1u << static_cast<unsigned>(kind);
+}
+
+//! Kinds which have mass, and so take part in collisions. Others are ghosts,
+//! which have no Narrowphase handler.
+const std::uint32_t SolidKinds = kindBit(EntityKind::Ship) | kindBit(EntityKind::BigRock)
+    | kindBit(EntityKind::MediumRock) | kindBit(EntityKind::SmallRock)
+    | kindBit(EntityKind::Bullet) | kindBit(EntityKind::Debris) | kindBit(EntityKind::Ufo);
+
+//! Returns the mask of kinds against which entities of kind are tested for
+//! contact. It is empty for ghost kinds, which are neither held in the
+//! collision broadphase nor iterated by the collision phase. The table is
+//! symmetric, i.e. if A is in the mask of B, then B is in the mask of A.
+//! All solid kinds rebound from each other, and bullets are spent on any
+//! contact, so each solid kind is tested against all others.
+inline std::uint32_t contactMask(EntityKind kind)
+{
+    static const std::uint32_t Table[static_cast<int>(EntityKind::Label) + 1] =
+    {
+        SolidKinds, // Ship
+        SolidKinds, // BigRock
+        SolidKinds, // MediumRock
+        SolidKinds, // SmallRock
+        SolidKinds, // Bullet
+        SolidKinds, // Debris
+        0, // Spark
+        SolidKinds, // Ufo
+        0 // Label
+    };
+
+    return Table[static_cast<int>(kind)];
+}
+
+//! Returns the mask of kinds to which entities of kind react at any distance,
+//! rather than on contact only. A UFO steers clear of kinds of greater mass
+//! than its own, and flocks with other UFOs. See Narrowphase.
+inline std::uint32_t sightMask(EntityKind kind)
+{
+    if (kind == EntityKind::Ufo)
+    {
+        return kindBit(EntityKind::Ship) | kindBit(EntityKind::BigRock)
+            | kindBit(EntityKind::MediumRock) | kindBit(EntityKind::SmallRock)
+            | kindBit(EntityKind::Ufo);
+    }
+
+    return 0;
+}
+
+}} // namespace
+#endif
@@ -16,15 +16,9 @@ using namespace Game::Internal;
 // CLASS Debris : PUBLIC MEMBERS
 //---------------------------------------------------------------------------
 Debris::Debris(Universe *owner)
-    : Rotator(owner)
+    : Rotator(owner, EntityKind::Debris)
 {
-    std::vector<PairXy> poly(4);
-    poly[0] = PairXy(0, 3);
-    poly[1] = PairXy(3, 0);
-    poly[2] = PairXy(-2, -3);
-    poly[3] = PairXy(0, 3);
-
-    setPolygon(poly);
+    setShape();
     setFragility(0);
     setRotation(owner->random(-M_PI / 15.0, +M_PI / 15.0));
     setMaxSeconds(owner->random(1, 3));
@@ -13,16 +13,12 @@
 namespace Game { namespace Internal {
 
 //! A short lived rotating rock-like particle with low mass.
-class Debris : public Rotator
+class Debris final : public Rotator
 {
 public:
 
     Debris(Universe *owner);
 
-    // Overrides
-    EntityKind kind() const override { return EntityKind::Debris; }
-    double mass() const override { return 3; }
-
 };
 
 }} // namespace
@@ -0,0 +1,106 @@
+//---------------------------------------------------------------------------
+// PROJECT      : Asteroid Style Game
+// COPYRIGHT    : Andy Thomas (C) 2019
+// WEB URL      : https://kuiper.zone
+// LICENSE      : GPLv3
+//---------------------------------------------------------------------------
+
+#include "entity_arena.h"
+
+#include <new>
+
+using namespace Game::Internal;
+
+//---------------------------------------------------------------------------
+// CLASS EntityArena : PUBLIC MEMBERS
+//---------------------------------------------------------------------------
+EntityArena::~EntityArena()
+{
+    for(std::size_t n = 0; n < _pools.size(); ++n)
+    {
+        Pool *pool = _pools[n];
+
+        for(std::size_t s = 0; s < pool->slabs.size(); ++s)
+        {
+            ::operator delete(pool->slabs[s]);
+        }
+
+        delete pool;
+    }
+}
+
+void* EntityArena::allocate(std::size_t size)
+{
+    // Round up to header size, which is also the alignment
+    size = (size + sizeof(Header) - 1) / sizeof(Header) * sizeof(Header);
+
+    // Only a handful of sizes are expected
+    Pool *pool = nullptr;
+
+    for(std::size_t n = 0; n < _pools.size(); ++n)
+    {
+        if (_pools[n]->size == size)
+        {
+            pool = _pools[n];
+            break;
+        }
+    }
+
+    if (pool == nullptr)
+    {
+        pool = new Pool();
+        pool->size = size;
+        pool->free = nullptr;
+
+        _pools.push_back(pool);
+        _heapCount += 1;
+    }
+
+    if (pool->free == nullptr)
+    {
+        grow(pool);
+    }
+
+    Header *block = pool->free;
+    pool->free = block->next;
+    block->pool = pool;
+
+    return block + 1;
+}
+
+void EntityArena::release(void *ptr)
+{
+    if (ptr != nullptr)
+    {
+        Header *block = static_cast<Header*>(ptr) - 1;
+        Pool *pool = block->pool;
+
+        block->next = pool->free;
+        pool->free = block;
+    }
+}
+
+std::int64_t EntityArena::heapCount() const
+{
+    return _heapCount;
+}
+
+//---------------------------------------------------------------------------
+// CLASS EntityArena : PRIVATE MEMBERS
+//---------------------------------------------------------------------------
+void EntityArena::grow(Pool *pool)
+{
+    std::size_t stride = sizeof(Header) + pool->size;
+    char *slab = static_cast<char*>(::operator new(stride * SlabBlocks));
+
+    pool->slabs.push_back(slab);
+    _heapCount += 1;
+
+    // Chain new blocks onto free list
+    for(int n = SlabBlocks - 1; n >= 0; --n)
+    {
+        Header *block = reinterpret_cast<Header*>(slab + stride * n);
+        block->next = pool->free;
+        pool->free = block;
+    }
+}
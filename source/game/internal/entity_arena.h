@@ -0,0 +1,76 @@
+//---------------------------------------------------------------------------
+// PROJECT      : Asteroid Style Game
+// COPYRIGHT    : Andy Thomas (C) 2019
+// WEB URL      : https://kuiper.zone
+// LICENSE      : GPLv3
+//---------------------------------------------------------------------------
+
+#ifndef GAME_ENTITY_ARENA_H
+#define GAME_ENTITY_ARENA_H
+
+#include <vector>
+#include <cstddef>
+#include <cstdint>
+
+namespace Game { namespace Internal {
+
+//! A slab allocator for game entities. Memory is taken from the heap in
+//! slabs, each holding a number of equal sized blocks, and a separate pool
+//! is kept for each block size requested. Released blocks are kept on a
+//! free list for reuse, so that once the game reaches a steady state, the
+//! creation and deletion of short-lived entities does not touch the heap.
+//! Memory is returned to the heap only when the arena is destroyed, at
+//! which point all blocks must have been released.
+class EntityArena
+{
+public:
+
+    //! Number of blocks per slab.
+    static const int SlabBlocks = 64;
+
+    //! Constructor.
+    EntityArena() = default;
+
+    //! Destructor. Frees all slabs.
+    ~EntityArena();
+
+    //! Returns a block of at least size bytes.
+    void* allocate(std::size_t size);
+
+    //! Releases a block to the arena from which it was allocated.
+    //! Does nothing if ptr is null.
+    static void release(void *ptr);
+
+    //! The total number of heap allocations made by the arena.
+    std::int64_t heapCount() const;
+
+private:
+
+    struct Pool;
+
+    // Block header, which is kept ahead of the memory given to the caller.
+    // Its alignment keeps the caller's memory suitably aligned.
+    union alignas(std::max_align_t) Header
+    {
+        Pool *pool;
+        Header *next;
+    };
+
+    struct Pool
+    {
+        std::size_t size;
+        Header *free;
+        std::vector<void*> slabs;
+    };
+
+    std::vector<Pool*> _pools;
+    std::int64_t _heapCount {0};
+
+    EntityArena(const EntityArena&) = delete;
+    EntityArena& operator=(const EntityArena&) = delete;
+
+    void grow(Pool *pool);
+};
+
+}} // namespace
+#endif
@@ -24,5 +24,29 @@ enum class EntityKind
     Label //!< Floating label.
 };
 
+//! Mass of entities of kind in arbitrary game units. Kinds with zero mass
+//! are ghosts which do not collide.
+inline constexpr double kindMass(EntityKind kind)
+{
+    return kind == EntityKind::Ship ? 20
+        : kind == EntityKind::BigRock ? 300
+        : kind == EntityKind::MediumRock ? 150
+        : kind == EntityKind::SmallRock ? 75
+        : kind == EntityKind::Bullet ? 1
+        : kind == EntityKind::Debris ? 3
+        : kind == EntityKind::Ufo ? 15
+        : 0;
+}
+
+//! Amount added to score where an entity of kind is hit by fire and destroyed.
+inline constexpr int kindScore(EntityKind kind)
+{
+    return kind == EntityKind::BigRock ? 100
+        : kind == EntityKind::MediumRock ? 50
+        : kind == EntityKind::SmallRock ? 25
+        : kind == EntityKind::Ufo ? 1000
+        : 0;
+}
+
 }} // namespace
 #endif
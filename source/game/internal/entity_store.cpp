@@ -0,0 +1,134 @@
+//---------------------------------------------------------------------------
+// PROJECT      : Asteroid Style Game
+// COPYRIGHT    : Andy Thomas (C) 2019
+// WEB URL      : https://kuiper.zone
+// LICENSE      : GPLv3
+//---------------------------------------------------------------------------
+
+#include "entity_store.h"
+#include "game_entity.h"
+
+#include <algorithm>
+
+using namespace Game;
+using namespace Game::Internal;
+
+//---------------------------------------------------------------------------
+// CLASS EntityStore : PUBLIC MEMBERS
+//---------------------------------------------------------------------------
+void EntityStore::reserve(std::size_t count)
+{
+    _entity.reserve(count);
+    _position.reserve(count);
+    _velocity.reserve(count);
+    _nextVelocity.reserve(count);
+    _radius.reserve(count);
+    _mass.reserve(count);
+    _kind.reserve(count);
+    _alive.reserve(count);
+}
+
+std::size_t EntityStore::insert(GameEntity *entity, EntityKind kind)
+{
+    _entity.push_back(entity);
+    _position.push_back(PairXy());
+    _velocity.push_back(PairXy());
+    _nextVelocity.push_back(PairXy());
+    _radius.push_back(0);
+    _mass.push_back(kindMass(kind));
+    _kind.push_back(kind);
+    _alive.push_back(1);
+
+    return _entity.size() - 1;
+}
+
+void EntityStore::release(std::size_t slot)
+{
+    _entity[slot] = nullptr;
+    _alive[slot] = 0;
+    _holes += 1;
+}
+
+void EntityStore::compact()
+{
+    if (_holes == 0)
+    {
+        return;
+    }
+
+    std::size_t count = 0;
+
+    for(std::size_t n = 0; n < _entity.size(); ++n)
+    {
+        if (_entity[n] != nullptr)
+        {
+            if (count != n)
+            {
+                _entity[count] = _entity[n];
+                _position[count] = _position[n];
+                _velocity[count] = _velocity[n];
+                _nextVelocity[count] = _nextVelocity[n];
+                _radius[count] = _radius[n];
+                _mass[count] = _mass[n];
+                _kind[count] = _kind[n];
+                _alive[count] = _alive[n];
+
+                _entity[count]->_slot = count;
+            }
+
+            count += 1;
+        }
+    }
+
+    _entity.resize(count);
+    _position.resize(count);
+    _velocity.resize(count);
+    _nextVelocity.resize(count);
+    _radius.resize(count);
+    _mass.resize(count);
+    _kind.resize(count);
+    _alive.resize(count);
+    _holes = 0;
+}
+
+void EntityStore::merge(EntityStore &other)
+{
+    std::size_t needed = size() + other.size() - other._holes;
+
+    if (needed > _entity.capacity())
+    {
+        // Grows geometrically, as push_back() would
+        reserve(std::max(needed, 2 * _entity.capacity()));
+    }
+
+    for(std::size_t n = 0; n < other.size(); ++n)
+    {
+        GameEntity *entity = other._entity[n];
+
+        if (entity != nullptr)
+        {
+            entity->_store = this;
+            entity->_slot = _entity.size();
+
+            _entity.push_back(entity);
+            _position.push_back(other._position[n]);
+            _velocity.push_back(other._velocity[n]);
+            _nextVelocity.push_back(other._nextVelocity[n]);
+            _radius.push_back(other._radius[n]);
+            _mass.push_back(other._mass[n]);
+            _kind.push_back(other._kind[n]);
+            _alive.push_back(other._alive[n]);
+        }
+    }
+
+    // Keeps capacity
+    other._entity.clear();
+    other._position.clear();
+    other._velocity.clear();
+    other._nextVelocity.clear();
+    other._radius.clear();
+    other._mass.clear();
+    other._kind.clear();
+    other._alive.clear();
+    other._holes = 0;
+}
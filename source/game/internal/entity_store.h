@@ -0,0 +1,110 @@
+//---------------------------------------------------------------------------
+// PROJECT      : Asteroid Style Game
+// COPYRIGHT    : Andy Thomas (C) 2019
+// WEB URL      : https://kuiper.zone
+// LICENSE      : GPLv3
+//---------------------------------------------------------------------------
+
+#ifndef GAME_ENTITY_STORE_H
+#define GAME_ENTITY_STORE_H
+
+#include "../pair_xy.h"
+#include "entity_kind.h"
+
+#include <vector>
+#include <cstddef>
+#include <cstdint>
+
+namespace Game { namespace Internal {
+
+// Forwards
+class GameEntity;
+
+//! Holds the physical state of game entities as a "struct of arrays", where
+//! each entity occupies one slot across a set of contiguous columns. Each
+//! GameEntity is a handle to its slot. Slot order is the order in which
+//! entities were inserted, and is the order in which they are advanced and
+//! drawn. Removing an entity leaves a
+//! "hole" in its slot, where entity() is null, until compact() is called.
+//! This allows any number of entities to be removed in a single linear pass.
+class EntityStore
+{
+public:
+
+    //! The number of slots.
+    std::size_t size() const { return _entity.size(); }
+
+    //! Reserves column capacity.
+    void reserve(std::size_t count);
+
+    //! Appends a new slot for entity of kind and returns its slot number.
+    //! The new slot is zero initialised, other than kind and mass, and is alive.
+    std::size_t insert(GameEntity *entity, EntityKind kind);
+
+    //! Releases a slot, leaving a hole where entity() is null and alive()
+    //! is false. The entity is not deleted.
+    void release(std::size_t slot);
+
+    //! Removes all holes, preserving the order of remaining slots, and
+    //! updates the slot number held by each moved entity.
+    void compact();
+
+    //! The number of holes awaiting compact().
+    std::size_t holes() const { return _holes; }
+
+    //! Moves all entities held by other to the end of this store in a single
+    //! batch, preserving their order. Holes in other are discarded and other
+    //! is left empty. Each moved entity becomes a handle into this store.
+    void merge(EntityStore &other);
+
+    //! Applies next velocity to velocity, and velocity to position.
+    void integrate(std::size_t slot)
+    {
+        _velocity[slot] = _nextVelocity[slot];
+        _position[slot] += _velocity[slot];
+    }
+
+    //! Column accessors.
+    GameEntity* entity(std::size_t slot) const { return _entity[slot]; }
+
+    PairXy& position(std::size_t slot) { return _position[slot]; }
+    const PairXy& position(std::size_t slot) const { return _position[slot]; }
+
+    PairXy& velocity(std::size_t slot) { return _velocity[slot]; }
+    const PairXy& velocity(std::size_t slot) const { return _velocity[slot]; }
+
+    PairXy& nextVelocity(std::size_t slot) { return _nextVelocity[slot]; }
+    const PairXy& nextVelocity(std::size_t slot) const { return _nextVelocity[slot]; }
+
+    Real& radius(std::size_t slot) { return _radius[slot]; }
+    Real radius(std::size_t slot) const { return _radius[slot]; }
+
+    Real mass(std::size_t slot) const { return _mass[slot]; }
+    EntityKind kind(std::size_t slot) const { return _kind[slot]; }
+
+    std::uint8_t& alive(std::size_t slot) { return _alive[slot]; }
+    bool alive(std::size_t slot) const { return _alive[slot] != 0; }
+
+    //! Column data, for kernels which process all slots together.
+    PairXy* positionData() { return _position.data(); }
+    PairXy* velocityData() { return _velocity.data(); }
+    const PairXy* nextVelocityData() const { return _nextVelocity.data(); }
+    const Real* radiusData() const { return _radius.data(); }
+    const Real* massData() const { return _mass.data(); }
+    const EntityKind* kindData() const { return _kind.data(); }
+
+private:
+
+    std::vector<GameEntity*> _entity;
+    std::vector<PairXy> _position;
+    std::vector<PairXy> _velocity;
+    std::vector<PairXy> _nextVelocity;
+    std::vector<Real> _radius;
+    std::vector<Real> _mass;
+    std::vector<EntityKind> _kind;
+    std::vector<std::uint8_t> _alive;
+    std::size_t _holes {0};
+};
+
+}} // namespace
+#endif
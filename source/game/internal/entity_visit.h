@@ -0,0 +1,109 @@
+//---------------------------------------------------------------------------
+// PROJECT      : Asteroid Style Game
+// COPYRIGHT    : Andy Thomas (C) 2019
+// WEB URL      : https://kuiper.zone
+// LICENSE      : GPLv3
+//---------------------------------------------------------------------------
+
+#ifndef GAME_ENTITY_VISIT_H
+#define GAME_ENTITY_VISIT_H
+
+#include "game_entity.h"
+#include "big_rock.h"
+#include "medium_rock.h"
+#include "small_rock.h"
+#include "debris.h"
+#include "spark.h"
+#include "ship.h"
+#include "ufo.h"
+#include "bullet.h"
+#include "label.h"
+
+namespace Game { namespace Internal {
+
+//! Calls func with entity as a pointer to its concrete type, as identified
+//! by kind(). Members are therefore dispatched statically, and may be inlined.
+//! Func is a functor with a call operator templated on the concrete type.
+//! The set of kinds is closed, where each has a single final subclass.
+template <typename Func>
+inline auto visit(GameEntity *entity, Func func) -> decltype(func(static_cast<Spark*>(entity)))
+{
+    switch (entity->kind())
+    {
+    case EntityKind::Ship: return func(static_cast<Ship*>(entity));
+    case EntityKind::BigRock: return func(static_cast<BigRock*>(entity));
+    case EntityKind::MediumRock: return func(static_cast<MediumRock*>(entity));
+    case EntityKind::SmallRock: return func(static_cast<SmallRock*>(entity));
+    case EntityKind::Bullet: return func(static_cast<Bullet*>(entity));
+    case EntityKind::Debris: return func(static_cast<Debris*>(entity));
+    case EntityKind::Spark: return func(static_cast<Spark*>(entity));
+    case EntityKind::Ufo: return func(static_cast<Ufo*>(entity));
+    default: return func(static_cast<Label*>(entity));
+    }
+}
+
+// Functors of the free functions below
+struct EntityAdvance
+{
+    template <typename T>
+    bool operator()(T *e) const { return e->advance(); }
+};
+
+struct EntityDraw
+{
+    PairXy view;
+
+    template <typename T>
+    bool operator()(T *e) const
+    {
+        double r = e->extent();
+
+        if (r >= 0)
+        {
+            PairXy p = e->position();
+
+            if (p.x() + r < 0 || p.y() + r < 0 || p.x() - r > view.x() || p.y() - r > view.y())
+            {
+                return false;
+            }
+        }
+
+        e->draw();
+        return true;
+    }
+};
+
+struct EntityDelete
+{
+    template <typename T>
+    void operator()(T *e) const { delete e; }
+};
+
+//! Calls advance() of the concrete type of entity.
+inline bool advanceEntity(GameEntity *entity)
+{
+    return visit(entity, EntityAdvance());
+}
+
+//! Calls draw() of the concrete type of entity, unless culled as the circle
+//! given by extent() lies wholly beyond the visible region from the origin
+//! to view. Returns true if drawn.
+inline bool drawEntity(GameEntity *entity, const PairXy &view)
+{
+    EntityDraw func;
+    func.view = view;
+    return visit(entity, func);
+}
+
+//! Deletes entity as its concrete type. Entities have no virtual destructor,
+//! and must not be deleted otherwise. Null is ignored.
+inline void destroy(GameEntity *entity)
+{
+    if (entity != nullptr)
+    {
+        visit(entity, EntityDelete());
+    }
+}
+
+}} // namespace
+#endif
@@ -16,30 +16,6 @@ using namespace Game::Internal;
 //---------------------------------------------------------------------------
 // CLASS Exploder : PUBLIC MEMBERS
 //---------------------------------------------------------------------------
-bool Exploder::crunch(GameEntity *other)
-{
-    // Max impact
-    static const double MaxImpact = SpeedOfLight / 4;
-
-    if (GameEntity::crunch(other))
-    {
-        // Destruction if mass of other is same or larger
-        if (_fragility > 0 && (other->mass() > mass()
-            || (other->mass() == mass() && owner()->random() < 0.5)))
-        {
-            // Actual destruction depends of velocity of impact and fragility
-            if ((velocity() - other->velocity()).abs() > MaxImpact * (1.0 - _fragility))
-            {
-                _destruction = true;
-            }
-        }
-
-        return true;
-    }
-
-    return false;
-}
-
 bool Exploder::advance()
 {
     // We still want to call base if collision is true
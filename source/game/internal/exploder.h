@@ -19,14 +19,15 @@ class Exploder : public GameEntity
 {
 public:
 
-    Exploder(Universe *owner)
-        : GameEntity(owner)
+    //! Constructor with the Universe to which the entity belongs, and the
+    //! kind of the concrete subclass.
+    Exploder(Universe *owner, EntityKind kind)
+        : GameEntity(owner, kind)
     {
     }
 
-    // Overrides
-    bool crunch(GameEntity *other) override;
-    bool advance() override;
+    //! Hides GameEntity::advance(). The entity explodes on return of false.
+    bool advance();
 
 protected:
 
@@ -49,6 +50,8 @@ protected:
 
 private:
 
+    friend class Narrowphase;
+
     bool _destruction {false};
     double _fragility {1.0};
     EntityKind _fragmentKind {EntityKind::Debris};
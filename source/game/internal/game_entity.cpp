@@ -9,6 +9,8 @@
 
 #include "scaled_canvas.h"
 #include "universe.h"
+#include "entity_store.h"
+#include "entity_arena.h"
 
 #include <cmath>
 #include <algorithm>
@@ -19,13 +21,19 @@ using namespace Game::Internal;
 //---------------------------------------------------------------------------
 // CLASS GameEntity : PUBLIC MEMBERS
 //---------------------------------------------------------------------------
-GameEntity::GameEntity(Universe *owner)
-    : _owner {owner}
+void* GameEntity::operator new(std::size_t size, Universe *owner)
 {
+    return owner->arena().allocate(size);
 }
 
-GameEntity::~GameEntity()
+void GameEntity::operator delete(void *ptr, Universe *)
 {
+    EntityArena::release(ptr);
+}
+
+void GameEntity::operator delete(void *ptr)
+{
+    EntityArena::release(ptr);
 }
 
 Universe* GameEntity::owner() const
@@ -33,25 +41,31 @@ Universe* GameEntity::owner() const
     return _owner;
 }
 
+std::uint64_t GameEntity::serial() const
+{
+    return _serial;
+}
+
 PairXy GameEntity::position() const
 {
-    return _position;
+    return _store->position(_slot);
 }
 
 void GameEntity::setPosition(const PairXy &value)
 {
-    _position = value;
+    _store->position(_slot) = value;
 }
 
 PairXy GameEntity::velocity() const
 {
-    return _velocity;
+    return _store->velocity(_slot);
 }
 
 void GameEntity::setVelocity(const PairXy &value)
 {
-    _velocity = value.throttle(SpeedOfLight);
-    _nextVelocity = _velocity;
+    PairXy vel = value.throttle(SpeedOfLight);
+    _store->velocity(_slot) = vel;
+    _store->nextVelocity(_slot) = vel;
 }
 
 double GameEntity::alpha() const
@@ -61,12 +75,18 @@ double GameEntity::alpha() const
 
 void GameEntity::setAlpha(double rads)
 {
-    setAlpha(rads, false);
+    // Applied to the shape only when drawn
+    _alpha = rads;
+}
+
+double GameEntity::extent() const
+{
+    return _shape != nullptr ? _shape->extent : 0;
 }
 
 double GameEntity::radius() const
 {
-    return _radius;
+    return _store->radius(_slot);
 }
 
 std::int64_t GameEntity::ticker() const
@@ -79,190 +99,71 @@ double GameEntity::maxSeconds() const
     return _maxSeconds;
 }
 
-bool GameEntity::crunch(GameEntity *other)
-{
-    // Coefficient of resitution
-    static const double CR = 0.90;
-
-    double m0 = mass();
-    double m1 = other->mass();
-
-    if (!_isAlive || m0 <= 0 || m1 <= 0)
-    {
-        // Ghost particles
-        return false;
-    }
-
-    // Do objects overlap?
-    auto dpos = position() - other->position();
-
-    if (dpos.abs() <= radius() + other->radius())
-    {
-        auto v0 = velocity();
-        auto v1 = other->velocity();
-
-        // Check moving toward each other?
-        if (dpos.abs() > (dpos + (v0 - v1) * 0.1).abs())
-        {
-            // Rebound - conservation of momentum
-            // https://physics.info/momentum-energy/
-            // https://en.wikipedia.org/wiki/Coefficient_of_restitution
-            _nextVelocity = (v0 * m0 + v1 * m1 + (v1 - v0) * m1 * CR) / (m0 + m1);
-
-            // Assume an energy loss (partially elastic)
-
-            // Fire kills
-            if (other->kind() == EntityKind::Bullet)
-            {
-                _isAlive = false;
-            }
-
-            return true;
-        }
-    }
-
-    return false;
-}
-
 bool GameEntity::advance()
 {
     _ticker += 1;
 
-    // Next holds result of collision
-    _velocity = _nextVelocity;
-
-    // New position
-    _position += _velocity;
-
     if (_maxTicks > 0 && _ticker > _maxTicks)
     {
-        _isAlive = false;
+        _store->alive(_slot) = 0;
     }
 
-    return _isAlive;
+    return _store->alive(_slot);
 }
 
 void GameEntity::draw()
 {
-    if (_isAlive)
+    if (_store->alive(_slot) && _shape != nullptr)
     {
-        PairXy last(true);
-        auto canvas = _owner->canvas();
-
-        auto &poly = polygon();
-
-        for(std::size_t n = 0; n < poly.size(); ++n)
-        {
-            PairXy p = poly[n] + position();
+        // Rotation is deferred to here, so that it is paid for only by entities
+        // drawn, and is applied with translation in a single pass
+        auto &poly = _shape->points;
+        auto &buf = _owner->drawBuffer();
 
-            if (!p.isNaN() && !last.isNaN())
-            {
-                canvas->drawLine(last, p);
-            }
+        buf.resize(poly.size());
+        _owner->kernels().transform(poly.data(), buf.data(), poly.size(),
+            cosine<Real>(_alpha), sine<Real>(_alpha), position());
 
-            last = p;
-        }
+        // Submitted as one batch
+        _owner->canvas()->drawPolyline(buf.data(), buf.size());
     }
 }
 
 //---------------------------------------------------------------------------
 // CLASS GameEntity : PROTECTED MEMBERS
 //---------------------------------------------------------------------------
-void GameEntity::setMaxSeconds(double sec)
+GameEntity::GameEntity(Universe *owner, EntityKind kind)
+    : _owner {owner}, _store {&owner->spawnBuffer()}, _serial {owner->newSerial()}, _kind {kind}
 {
-    _maxSeconds = sec;
-    _maxTicks = sec > 0 ? Universe::secondsToTicks(sec) : -1;
+    _slot = _store->insert(this, kind);
 }
 
-void GameEntity::setPolygon(const std::vector<PairXy> &points)
+GameEntity::~GameEntity()
 {
-    _polySource = points;
-    setAlpha(_alpha, true);
-
-    // Determine radius
-    _radius = 0;
-    int count = 0;
-
-    for(std::size_t n = 0; n < points.size(); ++n)
-    {
-        // NaN serves as a break, so count
-        // non-NaNs rather than rely on size().
-        if (!points[n].isNaN())
-        {
-            count += 1;
-            _radius += points[n].abs();
-        }
-    }
-
-    if (count != 0)
-    {
-        // Average
-        _radius /= count;
-    }
+    _store->release(_slot);
 }
 
-void GameEntity::setPolygon(double radius, int count, bool randomize)
+void GameEntity::setMaxSeconds(double sec)
 {
-    count = std::max(count, 4);
-    std::vector<PairXy> poly(count);
-
-    double alpha = 0.0;
-    double delta = 2.0 * M_PI / (count - 1);
-
-    for(int n = 0; n < count - 1; ++n)
-    {
-        PairXy p = PairXy(std::sin(alpha), std::cos(alpha)) * radius;
-
-        if (randomize && n > 0 && n < count - 1)
-        {
-            p.setX(_owner->random(p.x() * 0.8, p.x() * 1.2));
-            p.setY(_owner->random(p.y() * 0.8, p.y() * 1.2));
-        }
-
-        poly[n] = p;
-        alpha += delta;
-    }
-
-    // Connect final point
-    poly[count - 1] = poly[0];
-
-    setPolygon(poly);
-
+    _maxSeconds = sec;
+    _maxTicks = sec > 0 ? Universe::secondsToTicks(sec) : -1;
 }
 
-const std::vector<PairXy>& GameEntity::polygon() const
+void GameEntity::setShape()
 {
-    if (_polyAlpha.size() != 0)
-    {
-        return _polyAlpha;
-    }
-
-    return _polySource;
-}
+    const ShapeLibrary &lib = _owner->shapes();
+    int count = lib.variants(_kind);
 
-//---------------------------------------------------------------------------
-// CLASS GameEntity : PROTECTED MEMBERS
-//---------------------------------------------------------------------------
-void GameEntity::setAlpha(double rads, bool force)
-{
-    if (_alpha != rads || force)
+    if (count > 0)
     {
-        _alpha = rads;
+        int n = 0;
 
-        if (rads != 0)
+        if (count > 1)
         {
-            // Rotate
-            _polyAlpha.resize(_polySource.size());
-
-            for(std::size_t n = 0; n < _polySource.size(); ++n)
-            {
-                _polyAlpha[n] = _polySource[n].rotate(rads);
-            }
-        }
-        else
-        {
-            // Not needed. See polygon().
-            _polyAlpha.clear();
+            n = std::min(static_cast<int>(_owner->shapeRandom(0, count)), count - 1);
         }
+
+        _shape = &lib.shape(_kind, n);
+        _store->radius(_slot) = _shape->radius;
     }
 }
@@ -11,6 +11,7 @@
 #include "../pair_xy.h"
 #include "../sound_id.h"
 #include "entity_kind.h"
+#include "shape_library.h"
 
 #include <vector>
 #include <cstdint>
@@ -19,8 +20,14 @@ namespace Game { namespace Internal {
 
 // Forward declarations
 class Universe;
-
-//! An abstract base class for all objects in the game universe.
+class EntityStore;
+
+//! The base class for all objects in the game universe. Physical state
+//! (position, velocity, radius etc.) is held by the owner's EntityStore,
+//! where the instance acts as a handle to its slot. The set of subclasses is
+//! closed, and has no virtual methods. Rather, a subclass hides advance() and
+//! draw() as needed, and the owner calls them on the concrete type given by
+//! kind() using visit(). Likewise, an entity must be deleted using destroy().
 class GameEntity
 {
 public:
@@ -28,17 +35,52 @@ public:
     //! Maximum value of velocity axes.
     static const int SpeedOfLight = 20;
 
-    //! Constructor with the Universe to which the entity belongs.
-    GameEntity(Universe *owner);
-
-    //! Virtual destructor.
-    virtual ~GameEntity();
+    //! Geometry of a pair of entities, as seen from one of them. It is computed
+    //! once for each pair by the owner, and given to the Narrowphase handlers of
+    //! both, where that for the other is given by mirrored(). Mirroring is exact,
+    //! so that the result is the same as though computed by each, as negation
+    //! commutes with the subtraction and multiplication involved, for any Real.
+    struct Contact
+    {
+        //! Position of this less that of other.
+        PairXy offset;
+
+        //! Magnitude of offset. Valid only where touching, or where either
+        //! entity reacts to the other at any distance.
+        double distance {0};
+
+        //! True if the entities overlap, i.e. distance is no greater than
+        //! the sum of radii.
+        bool touching {false};
+
+        //! True if touching and moving toward each other.
+        bool approaching {false};
+
+        //! Returns the contact as seen from other.
+        Contact mirrored() const
+        {
+            Contact c = *this;
+            c.offset = PairXy() - offset;
+            return c;
+        }
+    };
+
+    //! Entities are allocated from the owner's EntityArena using the placement
+    //! form, i.e. "new (owner) Spark(owner)". Deleting an entity returns its
+    //! memory to the arena.
+    static void* operator new(std::size_t size, Universe *owner);
+    static void operator delete(void *ptr, Universe *owner);
+    static void operator delete(void *ptr);
 
     //! Gets the owning Universe of this instance.
     Universe* owner() const;
 
-    //! Identifies the entity kind. To be implemented by subclass.
-    virtual EntityKind kind() const = 0;
+    //! A number unique to the instance within its owner, assigned in order
+    //! of construction.
+    std::uint64_t serial() const;
+
+    //! Identifies the entity kind, as given on construction.
+    EntityKind kind() const { return _kind; }
 
     //! Position getter and setter as measured in arbitrary game units.
     //! The initial value is (0, 0).
@@ -57,17 +99,23 @@ public:
     void setAlpha(double rads);
 
     //! Amount added to score if entity is hit by fire and destroyed.
-    //! The base class implementation returns 0.
-    virtual int score() const { return 0; }
+    //! It is given by kindScore().
+    int score() const { return kindScore(_kind); }
 
     //! Mass in arbitrary game units. Objects with zero mass are ghost entities
-    //! which do not collide. The base implementation returns 0.
-    virtual double mass() const { return 0; }
+    //! which do not collide. It is given by kindMass().
+    double mass() const { return kindMass(_kind); }
 
     //! The object's size expressed as a radius. It is calculated
     //! automatically from the polygon and is used in collision detection.
     double radius() const;
 
+    //! Radius of a circle about position() which bounds all that draw() may
+    //! paint, used to cull entities beyond the visible region. A negative
+    //! value means unbounded, so the entity is never culled. The base
+    //! implementation returns the extent of the shape, or 0 if none.
+    double extent() const;
+
     //! The age of object in ticks. It is 0 on creation and incremented on
     //! each call to advance().
     std::int64_t ticker() const;
@@ -78,60 +126,52 @@ public:
     //! value is 0.
     double maxSeconds() const;
 
-    //! Calculates the object's reaction to another game object. If the two object's
-    //! are in collision, this instance will be rebound using conservation of momentum
-    //! laws (the state of other is unaffected). The result is true if the object is
-    //! in collision. It is anticipated that crunch() be called on every game entity
-    //! for every other entity prior to calling the advance() method. The method is
-    //! virtual so it may be overridden.
-    virtual bool crunch(GameEntity *other);
-
     //! Advances the object's state by one tick. This means that ticker() will be
-    //! incremented by +1 and position() will be incremented by velocity(). The
+    //! incremented by +1. Motion, where position() is incremented by velocity(),
+    //! is applied by the owner to all entities prior to calling advance(). The
     //! result is true if the object is "alive" on return, or false if the object
     //! has ceased to exist and should be removed from the game state. Note that
     //! this method may call owner()->add() to add items to the universe.
-    virtual bool advance();
+    bool advance();
 
     //! Draws the entity. The object is drawn on the owner() canvas as a
-    //! polygon defined by the setPolygon() method property.
-    virtual void draw();
+    //! polygon defined by setShape().
+    void draw();
 
 protected:
 
-    //! Protected setter for maxSeconds().
-    void setMaxSeconds(double sec);
+    //! Constructor with the Universe to which the entity belongs, and the
+    //! kind of the concrete subclass.
+    GameEntity(Universe *owner, EntityKind kind);
 
-    //! Sets polygon draw points. The polygon will be drawn as a sequence of lines
-    //! starting at points[0]. A PaiyXy value where isNaN() is true will serve as
-    //! a break in the sequence. This method is expected to be called in the
-    //! constructor of the subclass only in order to define the object's appearance.
-    void setPolygon(const std::vector<PairXy> &points);
+    //! Non-virtual destructor, see destroy().
+    ~GameEntity();
 
-    //! Sets circular polygon points derived from a radius value and a point count.
-    //! If randomize is true, the random variation is added to the point positions.
-    //! This method is typically used for generating asteroids.
-    void setPolygon(double radius, int count = 21, bool randomize = true);
+    //! Protected setter for maxSeconds().
+    void setMaxSeconds(double sec);
 
-    //! Gets the polygon points as rotated by alpha().
-    const std::vector<PairXy>& polygon() const;
+    //! Sets the polygon, and radius, to the shape of kind() held by the owner's
+    //! ShapeLibrary. Where the kind has several variants, such as rocks, one is
+    //! chosen at random. The shape is shared, rather than copied. This method is
+    //! expected to be called in the constructor of the subclass only in order to
+    //! define the object's appearance.
+    void setShape();
 
 private:
 
-    void setAlpha(double rads, bool force);
+    friend class EntityStore;
+    friend class Narrowphase;
 
     Universe * _owner;
-    bool _isAlive {true};
-    PairXy _position;
-    PairXy _velocity;
+    EntityStore * _store;
+    std::size_t _slot;
+    std::uint64_t _serial;
+    EntityKind _kind;
     double _alpha {0};
-    PairXy _nextVelocity;
-    double _radius {0};
     std::int64_t _ticker {0};
     double _maxSeconds {-1};
     std::int64_t _maxTicks {-1};
-    std::vector<PairXy> _polyAlpha;
-    std::vector<PairXy> _polySource;
+    const ShapeLibrary::Shape *_shape {nullptr};
 };
 
 }} // namespace
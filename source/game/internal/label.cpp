@@ -17,7 +17,7 @@ using namespace Game::Internal;
 // CLASS Label : PUBLIC MEMBERS
 //---------------------------------------------------------------------------
 Label::Label(Universe *owner, const std::string &text, double seconds)
-    : GameEntity(owner)
+    : GameEntity(owner, EntityKind::Label)
 {
     _text = text;
     setMaxSeconds(seconds);
@@ -15,7 +15,7 @@
 namespace Game { namespace Internal {
 
 //! A floating label entity. It can have motion, but is massless.
-class Label : public GameEntity
+class Label final : public GameEntity
 {
 public:
 
@@ -33,12 +33,9 @@ public:
     double rem() const;
     void setRem(double rem);
 
-    // Overrides
-    void draw() override;
-
-
-    // Overrides
-    EntityKind kind() const override { return EntityKind::Label; }
+    // Hides GameEntity. Text is unbounded, so is not culled.
+    double extent() const { return -1; }
+    void draw();
 
 protected:
 
@@ -16,9 +16,9 @@ using namespace Game::Internal;
 // CLASS MediumRock : PUBLIC MEMBERS
 //---------------------------------------------------------------------------
 MediumRock::MediumRock(Universe *owner)
-    : Rotator(owner)
+    : Rotator(owner, EntityKind::MediumRock)
 {
-    setPolygon(18.0);
+    setShape();
     setFragility(0.4);
     setFragmentKind(EntityKind::SmallRock);
     setFragmentCount(2);
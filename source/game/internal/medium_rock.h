@@ -14,16 +14,11 @@ namespace Game { namespace Internal {
 
 //! A concrete medium sized rock class. Derived from Rotator and fragments
 //! into small rocks when it explodes.
-class MediumRock : public Rotator
+class MediumRock final : public Rotator
 {
 public:
 
     MediumRock(Universe *owner);
-
-    // Overrides
-    EntityKind kind() const override { return EntityKind::MediumRock; }
-    int score() const override { return 50; };
-    double mass() const override { return 150; }
 };
 
 }} // namespace
@@ -0,0 +1,176 @@
+//---------------------------------------------------------------------------
+// PROJECT      : Asteroid Style Game
+// COPYRIGHT    : Andy Thomas (C) 2019
+// WEB URL      : https://kuiper.zone
+// LICENSE      : GPLv3
+//---------------------------------------------------------------------------
+
+#include "narrowphase.h"
+#include "bullet.h"
+#include "ufo.h"
+#include "universe.h"
+#include "entity_store.h"
+
+using namespace Game;
+using namespace Game::Internal;
+
+//---------------------------------------------------------------------------
+// NON-CLASS FUNCTIONS
+//---------------------------------------------------------------------------
+namespace {
+
+// Returns true if kind is a subclass of Exploder.
+inline constexpr bool isExploder(EntityKind kind)
+{
+    return kind == EntityKind::Ship || kind == EntityKind::BigRock
+        || kind == EntityKind::MediumRock || kind == EntityKind::SmallRock
+        || kind == EntityKind::Debris || kind == EntityKind::Ufo;
+}
+
+} // namespace
+
+//---------------------------------------------------------------------------
+// CLASS Narrowphase : PUBLIC MEMBERS
+//---------------------------------------------------------------------------
+Narrowphase::Handler Narrowphase::handler(EntityKind x, EntityKind y)
+{
+#define NARROWPHASE_ROW(X) { \
+    select<X, EntityKind::Ship>(), select<X, EntityKind::BigRock>(), \
+    select<X, EntityKind::MediumRock>(), select<X, EntityKind::SmallRock>(), \
+    select<X, EntityKind::Bullet>(), select<X, EntityKind::Debris>(), \
+    select<X, EntityKind::Spark>(), select<X, EntityKind::Ufo>(), \
+    select<X, EntityKind::Label>() }
+
+    static const int KindCount = static_cast<int>(EntityKind::Label) + 1;
+
+    // Indexed by kind of self, then other
+    static const Handler Table[KindCount][KindCount] =
+    {
+        NARROWPHASE_ROW(EntityKind::Ship),
+        NARROWPHASE_ROW(EntityKind::BigRock),
+        NARROWPHASE_ROW(EntityKind::MediumRock),
+        NARROWPHASE_ROW(EntityKind::SmallRock),
+        NARROWPHASE_ROW(EntityKind::Bullet),
+        NARROWPHASE_ROW(EntityKind::Debris),
+        NARROWPHASE_ROW(EntityKind::Spark),
+        NARROWPHASE_ROW(EntityKind::Ufo),
+        NARROWPHASE_ROW(EntityKind::Label)
+    };
+
+#undef NARROWPHASE_ROW
+
+    return Table[static_cast<int>(x)][static_cast<int>(y)];
+}
+
+//---------------------------------------------------------------------------
+// CLASS Narrowphase : PRIVATE MEMBERS
+//---------------------------------------------------------------------------
+template <EntityKind X, EntityKind Y>
+bool Narrowphase::respond(GameEntity *self, GameEntity *other,
+    const GameEntity::Contact &contact)
+{
+    // Coefficient of resitution
+    static const double CR = 0.90;
+
+    const double m0 = kindMass(X);
+    const double m1 = kindMass(Y);
+
+    if (X == EntityKind::Ufo && m1 > m0)
+    {
+        avoid(static_cast<Ufo*>(self), other, contact);
+    }
+
+    if (X == EntityKind::Ufo && Y == EntityKind::Ufo)
+    {
+        flock(static_cast<Ufo*>(self), other, contact);
+    }
+
+    // Do objects overlap, and are they moving toward each other?
+    if (!contact.touching || !contact.approaching || !self->_store->alive(self->_slot))
+    {
+        return false;
+    }
+
+    if (X != EntityKind::Bullet)
+    {
+        auto v0 = self->velocity();
+        auto v1 = other->velocity();
+
+        // Rebound - conservation of momentum
+        // https://physics.info/momentum-energy/
+        // https://en.wikipedia.org/wiki/Coefficient_of_restitution
+        self->_store->nextVelocity(self->_slot) = (v0 * m0 + v1 * m1 + (v1 - v0) * m1 * CR) / (m0 + m1);
+
+        // Assume an energy loss (partially elastic)
+    }
+
+    // Fire kills
+    if (Y == EntityKind::Bullet)
+    {
+        self->_store->alive(self->_slot) = 0;
+    }
+
+    if (X == EntityKind::Bullet)
+    {
+        // Spent, so its own rebound is of no consequence
+        static_cast<Bullet*>(self)->_hit = true;
+    }
+
+    if (isExploder(X))
+    {
+        impact(static_cast<Exploder*>(self), other, m1 > m0, m1 == m0);
+    }
+
+    return true;
+}
+
+void Narrowphase::avoid(Ufo *self, GameEntity *other, const GameEntity::Contact &contact)
+{
+    // Stay clear
+    PairXy vec = contact.offset;
+    double abs = contact.distance;
+
+    // Delta is ratio where: if delta < +1 = seriously close.
+    double delta = abs / (self->radius() + other->radius() * 5.0);
+
+    if (self->_avoidRockDelta <= 0 || delta < self->_avoidRockDelta)
+    {
+        self->_avoidRockDelta = delta;
+        self->_avoidRockVector = vec / abs;
+    }
+}
+
+void Narrowphase::flock(Ufo *self, GameEntity *other, const GameEntity::Contact &contact)
+{
+    PairXy vec = contact.offset;
+    double abs = contact.distance;
+
+    double delta = abs / (self->radius() + other->radius() * 2.0);
+
+    if (self->_avoidOtherDelta <= 0 || delta < self->_avoidOtherDelta)
+    {
+        self->_avoidOtherDelta = delta;
+        self->_avoidOtherVector = vec / abs;
+    }
+
+    self->_flockCount += 1;
+    self->_flockVector += vec;
+    self->_flockVelocity += other->velocity();
+}
+
+void Narrowphase::impact(Exploder *self, GameEntity *other, bool heavier, bool equal)
+{
+    // Max impact
+    static const double MaxImpact = GameEntity::SpeedOfLight / 4;
+
+    // Destruction if mass of other is same or larger
+    if (self->_fragility > 0 && (heavier
+        || (equal && self->owner()->random(self, other) < 0.5)))
+    {
+        // Actual destruction depends of velocity of impact and fragility
+        if ((self->velocity() - other->velocity()).abs() > MaxImpact * (1.0 - self->_fragility))
+        {
+            self->_destruction = true;
+        }
+    }
+}
@@ -0,0 +1,63 @@
+//---------------------------------------------------------------------------
+// PROJECT      : Asteroid Style Game
+// COPYRIGHT    : Andy Thomas (C) 2019
+// WEB URL      : https://kuiper.zone
+// LICENSE      : GPLv3
+//---------------------------------------------------------------------------
+
+#ifndef GAME_NARROWPHASE_H
+#define GAME_NARROWPHASE_H
+
+#include "entity_kind.h"
+#include "game_entity.h"
+
+namespace Game { namespace Internal {
+
+// Forward declarations
+class Exploder;
+class Ufo;
+
+//! The response of an entity to another in the collision phase. There is
+//! a handler for each pair of kinds, generated at compile time, so that the
+//! masses and behaviour of both are known to it. For example, a bullet on
+//! contact is simply spent, where its rebound would be moot, whereas a UFO
+//! both steers clear of a rock and rebounds from it.
+class Narrowphase
+{
+public:
+
+    //! Calculates the reaction of self to other, where contact is the geometry
+    //! of the pair as seen from self. If the two are in collision, self is
+    //! rebound using conservation of momentum laws. The result is true if in
+    //! collision. The owner calls the handler of both entities of each pair
+    //! which may interact, prior to calling advance(), with the partners of
+    //! each entity in ascending slot order. It modifies the state of self only,
+    //! and does not depend on the state of other other than that which is
+    //! fixed for the tick.
+    typedef bool (*Handler)(GameEntity *self, GameEntity *other,
+        const GameEntity::Contact &contact);
+
+    //! Returns the handler for self of kind x and other of kind y, or null
+    //! where either is a ghost kind, as the two never interact.
+    static Handler handler(EntityKind x, EntityKind y);
+
+private:
+
+    template <EntityKind X, EntityKind Y>
+    static bool respond(GameEntity *self, GameEntity *other,
+        const GameEntity::Contact &contact);
+
+    // Ghosts do not interact
+    template <EntityKind X, EntityKind Y>
+    static constexpr Handler select()
+    {
+        return kindMass(X) > 0 && kindMass(Y) > 0 ? &respond<X, Y> : nullptr;
+    }
+
+    static void avoid(Ufo *self, GameEntity *other, const GameEntity::Contact &contact);
+    static void flock(Ufo *self, GameEntity *other, const GameEntity::Contact &contact);
+    static void impact(Exploder *self, GameEntity *other, bool heavier, bool equal);
+};
+
+}} // namespace
+#endif
@@ -0,0 +1,104 @@
+//---------------------------------------------------------------------------
+// PROJECT      : Asteroid Style Game
+// COPYRIGHT    : Andy Thomas (C) 2019
+// WEB URL      : https://kuiper.zone
+// LICENSE      : GPLv3
+//---------------------------------------------------------------------------
+
+#ifndef GAME_RANDOM_H
+#define GAME_RANDOM_H
+
+#include <cstdint>
+
+namespace Game { namespace Internal {
+
+//! A fast pseudo random number generator, based on xoshiro256**. Its state is
+//! initialised from a seed and a stream number using SplitMix64, so that each
+//! (seed, stream) combination yields an independent sequence. This allows
+//! separate subsystems to draw numbers without affecting one another. The
+//! static hash() method supports counter-based use, where a value is derived
+//! from its inputs alone without holding any state.
+class Random
+{
+public:
+
+    //! Constructor with seed and stream number.
+    explicit Random(std::uint64_t seed = 0, std::uint64_t stream = 0)
+    {
+        this->seed(seed, stream);
+    }
+
+    //! Resets the state from seed and stream number.
+    void seed(std::uint64_t seed, std::uint64_t stream = 0)
+    {
+        std::uint64_t x = seed ^ mix(stream);
+
+        for(int n = 0; n < 4; ++n)
+        {
+            x += Golden;
+            _s[n] = mix(x);
+        }
+    }
+
+    //! Returns the next 64-bit value.
+    std::uint64_t next()
+    {
+        std::uint64_t result = rotl(_s[1] * 5, 7) * 9;
+        std::uint64_t t = _s[1] << 17;
+
+        _s[2] ^= _s[0];
+        _s[3] ^= _s[1];
+        _s[1] ^= _s[2];
+        _s[0] ^= _s[3];
+        _s[2] ^= t;
+        _s[3] = rotl(_s[3], 45);
+
+        return result;
+    }
+
+    //! Returns a value in the range [0, 1.0).
+    double real()
+    {
+        return toReal(next());
+    }
+
+    //! Returns a value in the range [min, max).
+    double real(double min, double max)
+    {
+        return min + (max - min) * toReal(next());
+    }
+
+    //! Hashes value to a well mixed 64-bit result (SplitMix64 finaliser).
+    //! Values may be combined as: hash(a ^ hash(b)).
+    static std::uint64_t hash(std::uint64_t x)
+    {
+        return mix(x + Golden);
+    }
+
+    //! Maps the top 53 bits of a 64-bit value to the range [0, 1.0).
+    static double toReal(std::uint64_t x)
+    {
+        return static_cast<double>(x >> 11) * (1.0 / 9007199254740992.0);
+    }
+
+private:
+
+    static const std::uint64_t Golden = 0x9E3779B97F4A7C15ULL;
+
+    std::uint64_t _s[4];
+
+    static std::uint64_t rotl(std::uint64_t x, int k)
+    {
+        return (x << k) | (x >> (64 - k));
+    }
+
+    static std::uint64_t mix(std::uint64_t x)
+    {
+        x = (x ^ (x >> 30)) * 0xBF58476D1CE4E5B9ULL;
+        x = (x ^ (x >> 27)) * 0x94D049BB133111EBULL;
+        return x ^ (x >> 31);
+    }
+};
+
+}} // namespace
+#endif
@@ -15,8 +15,8 @@ using namespace Game::Internal;
 //---------------------------------------------------------------------------
 // CLASS Rotator : PUBLIC MEMBERS
 //---------------------------------------------------------------------------
-Rotator::Rotator(Universe *owner)
-    : Exploder(owner)
+Rotator::Rotator(Universe *owner, EntityKind kind)
+    : Exploder(owner, kind)
 {
 }
 
@@ -17,12 +17,16 @@ class Rotator : public Exploder
 {
 public:
 
-    Rotator(Universe *owner);
+    //! Constructor with the Universe to which the entity belongs, and the
+    //! kind of the concrete subclass.
+    Rotator(Universe *owner, EntityKind kind);
 
     //! Rotation rate in radians per time tick. The initial value is 0.
     double rotation() const;
     void setRotation(double value);
-    bool advance() override;
+
+    //! Hides Exploder::advance().
+    bool advance();
 
 private:
 
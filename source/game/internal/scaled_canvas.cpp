@@ -16,7 +16,7 @@ using namespace Game::Internal;
 // CLASS ScaledCanvas : PUBLIC MEMBERS
 //---------------------------------------------------------------------------
 ScaledCanvas::ScaledCanvas(CanvasInterface *widget)
-    : _widget(widget)
+    : _widget(widget), _kernels(&kernels(SimdLevel::Scalar))
 {
 }
 
@@ -39,6 +39,22 @@ void ScaledCanvas::setSoundOn(bool on)
     }
 }
 
+void ScaledCanvas::setDeviceSize(double width, double height)
+{
+    if (width != _deviceWidth || height != _deviceHeight)
+    {
+        _deviceWidth = width;
+        _deviceHeight = height;
+        _width = -1;
+        _height = -1;
+    }
+}
+
+void ScaledCanvas::setKernels(const SimdKernels &value)
+{
+    _kernels = &value;
+}
+
 double ScaledCanvas::width() const
 {
     if (_width < 0)
@@ -82,6 +98,19 @@ void ScaledCanvas::drawLine(const PairXy &p1, const PairXy &p2)
     }
 }
 
+void ScaledCanvas::drawPolyline(const PairXy *points, std::size_t count)
+{
+    if (_scale > 0)
+    {
+        // Scaled in a single pass and passed on as one batch. Rotation by
+        // cosine scale and sine 0 is exact scaling, and NaN is preserved.
+        _buffer.resize(count);
+        _kernels->transform(points, _buffer.data(), count, _scale, 0, PairXy());
+
+        _widget->drawPolyline(_buffer.data(), count);
+    }
+}
+
 double ScaledCanvas::drawText(const PairXy &pos, AlignHorz horz, AlignVert vert,
     double rem, const std::string &text)
 {
@@ -93,6 +122,25 @@ double ScaledCanvas::drawText(const PairXy &pos, AlignHorz horz, AlignVert vert,
     return 0;
 }
 
+double ScaledCanvas::textHeight(double rem, const std::string &text) const
+{
+    double scale = _scale;
+
+    if (scale <= 0)
+    {
+        // Not drawing, so as at the next beginDraw()
+        calcDimensions(false);
+        scale = calcScale();
+    }
+
+    if (scale > 0)
+    {
+        return _widget->textHeight(rem * scale, text) / scale;
+    }
+
+    return 0;
+}
+
 void ScaledCanvas::playSound(SoundId id, SoundOpt opt)
 {
     if (_soundOn)
@@ -115,8 +163,9 @@ void ScaledCanvas::calcDimensions(bool setScale) const
     // while keeping the area approximately constant. This seems to
     // work well, allowing the window size to changed while
     // keeping the game in motion.
-    _width = _widget->width();
-    _height = _widget->height();
+    bool device = _deviceWidth >= 0 && _deviceHeight >= 0;
+    _width = device ? _deviceWidth : _widget->width();
+    _height = device ? _deviceHeight : _widget->height();
 
     if (_height > 0)
     {
@@ -127,15 +176,19 @@ void ScaledCanvas::calcDimensions(bool setScale) const
 
     if (setScale)
     {
-        if (_width > 0 && _height > 0)
-        {
-            _scale = std::sqrt((_widget->width() * _widget->height()) / (_width * _height));
-        }
-        else
-        {
-            // Not expected,
-            // but let's not crash.
-            _scale = 1.0;
-        }
+        _scale = calcScale();
     }
 }
+
+double ScaledCanvas::calcScale() const
+{
+    // Requires dimensions
+    if (_width > 0 && _height > 0)
+    {
+        return std::sqrt((_widget->width() * _widget->height()) / (_width * _height));
+    }
+
+    // Not expected,
+    // but let's not crash.
+    return 1.0;
+}
@@ -9,6 +9,9 @@
 #define GAME_SCALED_CANVAS_H
 
 #include "../canvas_interface.h"
+#include "simd_kernels.h"
+
+#include <vector>
 
 namespace Game { namespace Internal {
 
@@ -38,6 +41,17 @@ public:
     bool soundOn() const;
     void setSoundOn(bool on);
 
+    //! Overrides the widget dimensions from which the internal game dimensions
+    //! are calculated. This allows a game to be reproduced exactly, irrespective
+    //! of the actual size of the widget. Negative values restore the use of the
+    //! widget dimensions.
+    void setDeviceSize(double width, double height);
+
+    //! Sets the kernels with which drawPolyline() scales points. The owning
+    //! Universe sets those of its SIMD level. The initial value is those
+    //! of SimdLevel::Scalar.
+    void setKernels(const SimdKernels &value);
+
     //! Equivalent to: drawText(pos, AlignHorz::Center, AlignVert::Top, rem, text)
     inline double drawText(const PairXy &pos, double rem, const std::string &text)
     {
@@ -50,8 +64,10 @@ public:
     void beginDraw() override;
     void endDraw() override;
     void drawLine(const PairXy &p1, const PairXy &p2) override;
+    void drawPolyline(const PairXy *points, std::size_t count) override;
     double drawText(const PairXy &pos, AlignHorz horz, AlignVert vert,
         double rem, const std::string &text) override;
+    double textHeight(double rem, const std::string &text) const override;
     void playSound(SoundId id, SoundOpt opt) override;
     void stopSound(SoundId id) override;
 
@@ -63,9 +79,14 @@ private:
     mutable double _scale {-1};
     mutable double _width {-1};
     mutable double _height {-1};
+    double _deviceWidth {-1};
+    double _deviceHeight {-1};
     CanvasInterface *_widget;
+    const SimdKernels *_kernels;
+    std::vector<PairXy> _buffer;
 
     void calcDimensions(bool setScale) const;
+    double calcScale() const;
 };
 
 }} // namespace
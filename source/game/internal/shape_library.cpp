@@ -0,0 +1,131 @@
+//---------------------------------------------------------------------------
+// PROJECT      : Asteroid Style Game
+// COPYRIGHT    : Andy Thomas (C) 2019
+// WEB URL      : https://kuiper.zone
+// LICENSE      : GPLv3
+//---------------------------------------------------------------------------
+
+#include "shape_library.h"
+
+#include <cmath>
+#include <algorithm>
+
+using namespace Game;
+using namespace Game::Internal;
+
+//---------------------------------------------------------------------------
+// CLASS ShapeLibrary : PUBLIC MEMBERS
+//---------------------------------------------------------------------------
+void ShapeLibrary::build(Random &random)
+{
+    _shapes.clear();
+
+    // Shapes are held in order of kind
+    for(int k = 0; k < KindCount; ++k)
+    {
+        _first[k] = static_cast<int>(_shapes.size());
+
+        switch (static_cast<EntityKind>(k))
+        {
+        case EntityKind::Ship:
+            add({PairXy(0, -10), PairXy(7, 10), PairXy(0, 7), PairXy(-7, 10), PairXy(0, -10)});
+            break;
+        case EntityKind::BigRock:
+            for(int n = 0; n < RockVariants; ++n) addCircle(random, 30.0, 21);
+            break;
+        case EntityKind::MediumRock:
+            for(int n = 0; n < RockVariants; ++n) addCircle(random, 18.0, 21);
+            break;
+        case EntityKind::SmallRock:
+            for(int n = 0; n < RockVariants; ++n) addCircle(random, 10.0, 21);
+            break;
+        case EntityKind::Debris:
+            add({PairXy(0, 3), PairXy(3, 0), PairXy(-2, -3), PairXy(0, 3)});
+            break;
+        case EntityKind::Spark:
+            add({PairXy(0.0, 1.0), PairXy(0.0, -1.0)});
+            break;
+        case EntityKind::Ufo:
+            add({PairXy(5.0, -5.0), PairXy(10.0, -2.0), PairXy(10.0, 2.0), PairXy(8.0, 4.0),
+                PairXy(-2.0, 4.0), PairXy(-2.0, 2.0), PairXy(2.0, 2.0), PairXy(2.0, 4.0),
+                PairXy(-8.0, 4.0), PairXy(-10.0, 2.0), PairXy(-10.0, -2.0), PairXy(10.0, -2.0),
+                PairXy(10.0, 2.0), PairXy(-10.0, 2.0), PairXy(-10.0, -2.0), PairXy(-5.0, -5.0),
+                PairXy(0.0, -5.0), PairXy(-7.0, -2.0), PairXy(-5.0, -5.0), PairXy(5.0, -5.0)});
+            break;
+        default:
+            // Bullet and Label draw themselves
+            break;
+        }
+    }
+
+    _first[KindCount] = static_cast<int>(_shapes.size());
+}
+
+int ShapeLibrary::variants(EntityKind kind) const
+{
+    int k = static_cast<int>(kind);
+    return _first[k + 1] - _first[k];
+}
+
+//---------------------------------------------------------------------------
+// CLASS ShapeLibrary : PRIVATE MEMBERS
+//---------------------------------------------------------------------------
+void ShapeLibrary::add(const std::vector<PairXy> &points)
+{
+    Shape shape;
+    shape.points = points;
+
+    // Determine radius
+    int count = 0;
+
+    for(std::size_t n = 0; n < points.size(); ++n)
+    {
+        // NaN serves as a break, so count
+        // non-NaNs rather than rely on size().
+        if (!points[n].isNaN())
+        {
+            double abs = points[n].abs();
+            shape.extent = std::max(shape.extent, abs);
+
+            count += 1;
+            shape.radius += abs;
+        }
+    }
+
+    if (count != 0)
+    {
+        // Average
+        shape.radius /= count;
+    }
+
+    _shapes.push_back(shape);
+}
+
+void ShapeLibrary::addCircle(Random &random, double radius, int count)
+{
+    // Circular points with random variation, as for rocks
+    count = std::max(count, 4);
+    std::vector<PairXy> poly(count);
+
+    double alpha = 0.0;
+    double delta = 2.0 * M_PI / (count - 1);
+
+    for(int n = 0; n < count - 1; ++n)
+    {
+        PairXy p = PairXy(sine<Real>(alpha), cosine<Real>(alpha)) * radius;
+
+        if (n > 0)
+        {
+            p.setX(random.real(p.x() * 0.8, p.x() * 1.2));
+            p.setY(random.real(p.y() * 0.8, p.y() * 1.2));
+        }
+
+        poly[n] = p;
+        alpha += delta;
+    }
+
+    // Connect final point
+    poly[count - 1] = poly[0];
+
+    add(poly);
+}
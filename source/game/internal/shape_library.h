@@ -0,0 +1,71 @@
+//---------------------------------------------------------------------------
+// PROJECT      : Asteroid Style Game
+// COPYRIGHT    : Andy Thomas (C) 2019
+// WEB URL      : https://kuiper.zone
+// LICENSE      : GPLv3
+//---------------------------------------------------------------------------
+
+#ifndef GAME_SHAPE_LIBRARY_H
+#define GAME_SHAPE_LIBRARY_H
+
+#include "../pair_xy.h"
+#include "entity_kind.h"
+#include "random.h"
+
+#include <vector>
+
+namespace Game { namespace Internal {
+
+//! An immutable set of polygon outlines shared by all entities of a Universe,
+//! so that entities hold a reference to a shape rather than its points. Each
+//! kind with an outline has a single shape, other than rocks, which have a
+//! pool of randomized variants. The library is built once by the owner.
+class ShapeLibrary
+{
+public:
+
+    //! A polygon outline in entity coordinates, i.e. prior to rotation and
+    //! translation. It is drawn as a sequence of lines starting at points[0],
+    //! where a PairXy value for which isNaN() is true serves as a break.
+    struct Shape
+    {
+        std::vector<PairXy> points;
+
+        //! Mean distance of points from the origin, used in collision detection.
+        double radius {0};
+
+        //! Greatest distance of points from the origin, i.e. the radius of a
+        //! circle which bounds the outline. Used in view culling.
+        double extent {0};
+    };
+
+    //! Number of randomized variants of each rock kind.
+    static const int RockVariants = 16;
+
+    //! Builds all shapes, where rock outlines are randomized using random.
+    //! Existing shapes are replaced, and must not be referenced.
+    void build(Random &random);
+
+    //! Returns the number of variants of kind, which is 0 where kind has no
+    //! outline.
+    int variants(EntityKind kind) const;
+
+    //! Returns variant n of kind, where n is in range [0, variants(kind)).
+    const Shape& shape(EntityKind kind, int n = 0) const
+    {
+        return _shapes[_first[static_cast<int>(kind)] + n];
+    }
+
+private:
+
+    static const int KindCount = static_cast<int>(EntityKind::Label) + 1;
+
+    std::vector<Shape> _shapes;
+    int _first[KindCount + 1] {};
+
+    void add(const std::vector<PairXy> &points);
+    void addCircle(Random &random, double radius, int count);
+};
+
+}} // namespace
+#endif
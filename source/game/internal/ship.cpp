@@ -19,17 +19,9 @@ using namespace Game::Internal;
 // CLASS Ship : PUBLIC MEMBERS
 //---------------------------------------------------------------------------
 Ship::Ship(Universe *owner)
-    : Exploder(owner)
+    : Exploder(owner, EntityKind::Ship)
 {
-    std::vector<PairXy> poly(5);
-
-    poly[0] = PairXy(0, -10);
-    poly[1] = PairXy(7, 10);
-    poly[2] = PairXy(0, 7);
-    poly[3] = PairXy(-7, 10);
-    poly[4] = PairXy(0, -10);
-
-    setPolygon(poly);
+    setShape();
 
     // Gun & thrust postions
     _nosePos = PairXy(0, -14);
@@ -86,7 +78,7 @@ bool Ship::advance()
             PairXy tplane = _thrustPlane.rotate(rads);
 
             // Determine thrust vector
-            PairXy tvec(std::sin(rads), -std::cos(rads));
+            PairXy tvec(sine<Real>(rads), -cosine<Real>(rads));
 
             // Add thrust to velocity.
             setVelocity((velocity() + tvec * ThrustFactor).throttle(MaxSpeed));
@@ -98,7 +90,7 @@ bool Ship::advance()
             {
                 // Generate exhaust along the plane
                 PairXy temp(tpos + tplane * owner()->random());
-                owner()->add(new Spark(owner()), position() + temp, xvec)->setAlpha(rads);
+                owner()->add(owner()->create(EntityKind::Spark), position() + temp, xvec)->setAlpha(rads);
             }
 
             if (!_thrustSound)
@@ -119,7 +111,7 @@ bool Ship::advance()
         if (_firing && _fireLock == 0 && _charge > 0)
         {
             // Create bullet heading
-            PairXy bvec(std::sin(rads), -std::cos(rads));
+            PairXy bvec(sine<Real>(rads), -cosine<Real>(rads));
             bvec *= BulletSpeed;
             bvec += velocity();
 
@@ -131,7 +123,7 @@ bool Ship::advance()
             _fireLock = LockInc;
 
             PairXy temp = _nosePos.rotate(rads);
-            owner()->add(new Bullet(owner(), bvec), position() + temp, bvec);
+            owner()->add(new (owner()) Bullet(owner(), bvec), position() + temp, bvec);
 
             owner()->canvas()->playSound(SoundId::GunFire, SoundOpt::Restart);
         }
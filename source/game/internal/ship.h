@@ -13,7 +13,7 @@
 namespace Game { namespace Internal {
 
 //! The ship.
-class Ship : public Exploder
+class Ship final : public Exploder
 {
 public:
 
@@ -35,10 +35,8 @@ public:
     //! Gets amount of charge available for firing.
     int charge() const;
 
-    // Overrides
-    EntityKind kind() const override { return EntityKind::Ship; }
-    double mass() const override { return 20; }
-    bool advance() override;
+    // Hides Exploder
+    bool advance();
 
 private:
 
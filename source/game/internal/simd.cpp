@@ -0,0 +1,146 @@
+//---------------------------------------------------------------------------
+// PROJECT      : Asteroid Style Game
+// COPYRIGHT    : Andy Thomas (C) 2019
+// WEB URL      : https://kuiper.zone
+// LICENSE      : GPLv3
+//---------------------------------------------------------------------------
+
+#include "simd.h"
+
+#include <cctype>
+#include <cstdlib>
+
+#if defined(_MSC_VER) && (defined(_M_X64) || defined(_M_IX86))
+    #include <intrin.h>
+    #include <immintrin.h>
+#endif
+
+using namespace Game::Internal;
+
+namespace {
+
+const int LevelCount = static_cast<int>(SimdLevel::Avx512) + 1;
+
+const char* const LevelNames[LevelCount] = {"scalar", "sse2", "sse4.2", "avx2", "avx512"};
+
+// Greatest level for which kernels are built
+SimdLevel buildLevel()
+{
+#if defined(GAME_SIMD_X86)
+    return SimdLevel::Avx512;
+#else
+    return SimdLevel::Scalar;
+#endif
+}
+
+// Greatest level supported by CPU and operating system
+SimdLevel cpuLevel()
+{
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+    // These check that the OS saves the wider registers
+    __builtin_cpu_init();
+
+    if (__builtin_cpu_supports("avx512f")) return SimdLevel::Avx512;
+    if (__builtin_cpu_supports("avx2")) return SimdLevel::Avx2;
+    if (__builtin_cpu_supports("sse4.2")) return SimdLevel::Sse42;
+    if (__builtin_cpu_supports("sse2")) return SimdLevel::Sse2;
+
+#elif defined(_MSC_VER) && (defined(_M_X64) || defined(_M_IX86))
+    int r1[4], r7[4];
+    __cpuid(r1, 1);
+    __cpuidex(r7, 7, 0);
+
+    bool sse2 = (r1[3] & (1 << 26)) != 0;
+    bool sse42 = (r1[2] & (1 << 20)) != 0;
+    bool osxsave = (r1[2] & (1 << 27)) != 0;
+    unsigned long long xcr0 = osxsave ? _xgetbv(0) : 0;
+
+    // OS must save YMM, and for AVX-512 also opmask and ZMM state
+    bool avx2 = (r7[1] & (1 << 5)) != 0 && (xcr0 & 0x06) == 0x06;
+    bool avx512 = (r7[1] & (1 << 16)) != 0 && (xcr0 & 0xE6) == 0xE6;
+
+    if (avx512) return SimdLevel::Avx512;
+    if (avx2) return SimdLevel::Avx2;
+    if (sse42) return SimdLevel::Sse42;
+    if (sse2) return SimdLevel::Sse2;
+#endif
+
+    return SimdLevel::Scalar;
+}
+
+SimdLevel lesser(SimdLevel a, SimdLevel b)
+{
+    return static_cast<int>(a) < static_cast<int>(b) ? a : b;
+}
+
+SimdLevel initialDefault()
+{
+    SimdLevel level = simdDetected();
+    const char *env = std::getenv("ASTEROID_SIMD");
+    SimdLevel forced;
+
+    if (env != nullptr && simdParse(env, forced))
+    {
+        level = lesser(forced, level);
+    }
+
+    return level;
+}
+
+SimdLevel& defaultLevel()
+{
+    static SimdLevel level = initialDefault();
+    return level;
+}
+
+} // namespace
+
+//---------------------------------------------------------------------------
+// NON-CLASS FUNCTIONS
+//---------------------------------------------------------------------------
+SimdLevel Game::Internal::simdDetected()
+{
+    static const SimdLevel level = lesser(cpuLevel(), buildLevel());
+    return level;
+}
+
+bool Game::Internal::simdSupported(SimdLevel level)
+{
+    return static_cast<int>(level) <= static_cast<int>(simdDetected());
+}
+
+SimdLevel Game::Internal::simdDefault()
+{
+    return defaultLevel();
+}
+
+void Game::Internal::setSimdDefault(SimdLevel level)
+{
+    defaultLevel() = lesser(level, simdDetected());
+}
+
+const char* Game::Internal::simdName(SimdLevel level)
+{
+    return LevelNames[static_cast<int>(level)];
+}
+
+bool Game::Internal::simdParse(const std::string &name, SimdLevel &level)
+{
+    std::string lower;
+
+    for(std::size_t n = 0; n < name.size(); ++n)
+    {
+        lower += static_cast<char>(std::tolower(static_cast<unsigned char>(name[n])));
+    }
+
+    for(int n = 0; n < LevelCount; ++n)
+    {
+        if (lower == LevelNames[n])
+        {
+            level = static_cast<SimdLevel>(n);
+            return true;
+        }
+    }
+
+    return false;
+}
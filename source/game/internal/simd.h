@@ -0,0 +1,57 @@
+//---------------------------------------------------------------------------
+// PROJECT      : Asteroid Style Game
+// COPYRIGHT    : Andy Thomas (C) 2019
+// WEB URL      : https://kuiper.zone
+// LICENSE      : GPLv3
+//---------------------------------------------------------------------------
+
+#ifndef GAME_SIMD_H
+#define GAME_SIMD_H
+
+#include <string>
+
+// SIMD kernels operate on PairXy arrays as arrays of double,
+// so are built only for x86 where Real is double.
+#if (defined(__x86_64__) || defined(_M_X64) || defined(__SSE2__)) \
+    && !defined(GAME_REAL_FLOAT) && !defined(GAME_REAL_FIXED)
+    #define GAME_SIMD_X86
+#endif
+
+namespace Game { namespace Internal {
+
+//! Instruction set level of kernel implementations, in ascending order.
+enum class SimdLevel
+{
+    Scalar, //!< Plain C++.
+    Sse2, //!< SSE2, two doubles per instruction.
+    Sse42, //!< SSE4.2, adds blend instructions.
+    Avx2, //!< AVX2, four doubles per instruction.
+    Avx512 //!< AVX-512F, eight doubles per instruction.
+};
+
+//! Returns the greatest level supported by both the CPU, which is detected
+//! on first call, and the build. SIMD kernels are built on x86 only, and only
+//! where Real is double. Otherwise the result is Scalar.
+SimdLevel simdDetected();
+
+//! Returns true if level is no greater than simdDetected().
+bool simdSupported(SimdLevel level);
+
+//! Gets and sets the level with which new Universe instances start. It is
+//! initially simdDetected() or, if the environment variable ASTEROID_SIMD
+//! names a level (see simdParse()), the lesser of that and simdDetected().
+//! A value greater than simdDetected() is reduced to it. Intended to force a
+//! level for benchmarking. Not thread safe.
+SimdLevel simdDefault();
+void setSimdDefault(SimdLevel level);
+
+//! Returns a lowercase name, i.e. "scalar", "sse2", "sse4.2", "avx2" or
+//! "avx512".
+const char* simdName(SimdLevel level);
+
+//! Parses a name given by simdName(), ignoring case. The result is false
+//! if name is not recognised, in which case level is not changed.
+bool simdParse(const std::string &name, SimdLevel &level);
+
+}} // namespace
+#endif
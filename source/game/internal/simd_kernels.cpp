@@ -0,0 +1,514 @@
+//---------------------------------------------------------------------------
+// PROJECT      : Asteroid Style Game
+// COPYRIGHT    : Andy Thomas (C) 2019
+// WEB URL      : https://kuiper.zone
+// LICENSE      : GPLv3
+//---------------------------------------------------------------------------
+
+#include "simd_kernels.h"
+
+#if defined(GAME_SIMD_X86)
+    #include <immintrin.h>
+
+    // Allows functions for levels above that targeted by the build. They
+    // are bound by kernels() only where the CPU supports them. Note that the
+    // build must not contract multiply-add into FMA. See common.pri.
+    #if defined(__GNUC__)
+        #define TARGET_SSE42 __attribute__((target("sse4.2")))
+        #define TARGET_AVX2 __attribute__((target("avx2")))
+        #define TARGET_AVX512 __attribute__((target("avx512f")))
+    #else
+        #define TARGET_SSE42
+        #define TARGET_AVX2
+        #define TARGET_AVX512
+    #endif
+
+    // Gathers take 64-bit indices
+    #if defined(__x86_64__) || defined(_M_X64)
+        #define GATHER_SIZE_T
+    #endif
+#endif
+
+using namespace Game;
+using namespace Game::Internal;
+
+namespace {
+
+// Number of bits set
+inline std::size_t bitCount(unsigned value)
+{
+    std::size_t count = 0;
+
+    for(; value != 0; value &= value - 1)
+    {
+        ++count;
+    }
+
+    return count;
+}
+
+// Margins of slot n
+inline void margins(const Real *radius, const EntityKind *kind, std::size_t n,
+    const WrapBounds &bounds, Real &mx, Real &my)
+{
+    if ((bounds.deepKinds >> static_cast<unsigned>(kind[n])) & 1u)
+    {
+        mx = bounds.kuiper.x();
+        my = bounds.kuiper.y();
+    }
+    else
+    {
+        mx = radius[n];
+        my = radius[n];
+    }
+}
+
+//---------------------------------------------------------------------------
+// SCALAR
+//---------------------------------------------------------------------------
+void integrateScalar(PairXy *position, PairXy *velocity,
+    const PairXy *nextVelocity, std::size_t count)
+{
+    for(std::size_t n = 0; n < count; ++n)
+    {
+        velocity[n] = nextVelocity[n];
+        position[n] += velocity[n];
+    }
+}
+
+// Wraps slots from begin to count
+void wrapFrom(PairXy *position, const Real *radius, const EntityKind *kind,
+    std::size_t begin, std::size_t count, const WrapBounds &bounds)
+{
+    Real cx = bounds.extent.x();
+    Real cy = bounds.extent.y();
+
+    for(std::size_t n = begin; n < count; ++n)
+    {
+        PairXy &pos = position[n];
+        Real mx, my;
+        margins(radius, kind, n, bounds, mx, my);
+
+        if (pos.x() < -mx) pos.setX(cx + mx);
+        else if (pos.x() > cx + mx) pos.setX(-mx);
+
+        if (pos.y() < -my) pos.setY(cy + my);
+        else if (pos.y() > cy + my) pos.setY(-my);
+    }
+}
+
+void wrapScalar(PairXy *position, const Real *radius, const EntityKind *kind,
+    std::size_t count, const WrapBounds &bounds)
+{
+    wrapFrom(position, radius, kind, 0, count, bounds);
+}
+
+void transformScalar(const PairXy *src, PairXy *dest, std::size_t count,
+    Real cs, Real sn, const PairXy &offset)
+{
+    for(std::size_t n = 0; n < count; ++n)
+    {
+        dest[n] = src[n].isNaN() ? src[n] : src[n].rotate(cs, sn) + offset;
+    }
+}
+
+std::size_t overlapScalar(const PairXy *position, const Real *radius, const Real *mass,
+    std::size_t self, const std::size_t *index, std::size_t count, std::size_t *dest)
+{
+    std::size_t hits = 0;
+
+    for(std::size_t n = 0; n < count; ++n)
+    {
+        std::size_t y = index[n];
+        double r = radius[self] + radius[y];
+
+        if (mass[y] > 0 && (position[self] - position[y]).absSquared() <= r * r * OverlapMargin)
+        {
+            dest[hits++] = y;
+        }
+    }
+
+    return hits;
+}
+
+#if defined(GAME_SIMD_X86)
+//---------------------------------------------------------------------------
+// SSE2
+//---------------------------------------------------------------------------
+void integrateSse2(PairXy *position, PairXy *velocity,
+    const PairXy *nextVelocity, std::size_t count)
+{
+    double *p = reinterpret_cast<double*>(position);
+    double *v = reinterpret_cast<double*>(velocity);
+    const double *nv = reinterpret_cast<const double*>(nextVelocity);
+
+    // One PairXy per register
+    for(std::size_t n = 0; n < 2 * count; n += 2)
+    {
+        __m128d a = _mm_loadu_pd(nv + n);
+        _mm_storeu_pd(v + n, a);
+        _mm_storeu_pd(p + n, _mm_add_pd(_mm_loadu_pd(p + n), a));
+    }
+}
+
+void wrapSse2(PairXy *position, const Real *radius, const EntityKind *kind,
+    std::size_t count, const WrapBounds &bounds)
+{
+    // Negation by sign bit, which is exact for 0
+    const __m128d sign = _mm_set1_pd(-0.0);
+    const __m128d ext = _mm_set_pd(bounds.extent.y(), bounds.extent.x());
+
+    for(std::size_t n = 0; n < count; ++n)
+    {
+        Real mx, my;
+        margins(radius, kind, n, bounds, mx, my);
+
+        __m128d m = _mm_set_pd(my, mx);
+        __m128d lo = _mm_xor_pd(m, sign);
+        __m128d hi = _mm_add_pd(ext, m);
+
+        double *p = reinterpret_cast<double*>(position + n);
+        __m128d v = _mm_loadu_pd(p);
+
+        // Comparisons are false for NaN, as in scalar
+        __m128d gt = _mm_cmpgt_pd(v, hi);
+        __m128d lt = _mm_cmplt_pd(v, lo);
+        __m128d r = _mm_or_pd(_mm_and_pd(gt, lo), _mm_andnot_pd(gt, v));
+        r = _mm_or_pd(_mm_and_pd(lt, hi), _mm_andnot_pd(lt, r));
+        _mm_storeu_pd(p, r);
+    }
+}
+
+void transformSse2(const PairXy *src, PairXy *dest, std::size_t count,
+    Real cs, Real sn, const PairXy &offset)
+{
+    // Rotation is cs * (x, y) + sn * (-y, x). Negating the product,
+    // rather than subtracting it, gives the same result as scalar.
+    const __m128d csv = _mm_set1_pd(cs);
+    const __m128d snv = _mm_set1_pd(sn);
+    const __m128d sign = _mm_set_pd(0.0, -0.0);
+    const __m128d off = _mm_set_pd(offset.y(), offset.x());
+
+    for(std::size_t n = 0; n < count; ++n)
+    {
+        __m128d v = _mm_loadu_pd(reinterpret_cast<const double*>(src + n));
+        __m128d w = _mm_shuffle_pd(v, v, 1);
+        __m128d r = _mm_add_pd(_mm_mul_pd(csv, v), _mm_xor_pd(_mm_mul_pd(snv, w), sign));
+        r = _mm_add_pd(r, off);
+
+        // Keep point where either component is NaN
+        __m128d nan = _mm_cmpunord_pd(v, v);
+        nan = _mm_or_pd(nan, _mm_shuffle_pd(nan, nan, 1));
+        r = _mm_or_pd(_mm_and_pd(nan, v), _mm_andnot_pd(nan, r));
+        _mm_storeu_pd(reinterpret_cast<double*>(dest + n), r);
+    }
+}
+
+//---------------------------------------------------------------------------
+// SSE4.2
+//---------------------------------------------------------------------------
+TARGET_SSE42
+void wrapSse42(PairXy *position, const Real *radius, const EntityKind *kind,
+    std::size_t count, const WrapBounds &bounds)
+{
+    const __m128d sign = _mm_set1_pd(-0.0);
+    const __m128d ext = _mm_set_pd(bounds.extent.y(), bounds.extent.x());
+
+    for(std::size_t n = 0; n < count; ++n)
+    {
+        Real mx, my;
+        margins(radius, kind, n, bounds, mx, my);
+
+        __m128d m = _mm_set_pd(my, mx);
+        __m128d lo = _mm_xor_pd(m, sign);
+        __m128d hi = _mm_add_pd(ext, m);
+
+        double *p = reinterpret_cast<double*>(position + n);
+        __m128d v = _mm_loadu_pd(p);
+
+        __m128d r = _mm_blendv_pd(v, lo, _mm_cmpgt_pd(v, hi));
+        r = _mm_blendv_pd(r, hi, _mm_cmplt_pd(v, lo));
+        _mm_storeu_pd(p, r);
+    }
+}
+
+TARGET_SSE42
+void transformSse42(const PairXy *src, PairXy *dest, std::size_t count,
+    Real cs, Real sn, const PairXy &offset)
+{
+    const __m128d csv = _mm_set1_pd(cs);
+    const __m128d snv = _mm_set1_pd(sn);
+    const __m128d sign = _mm_set_pd(0.0, -0.0);
+    const __m128d off = _mm_set_pd(offset.y(), offset.x());
+
+    for(std::size_t n = 0; n < count; ++n)
+    {
+        __m128d v = _mm_loadu_pd(reinterpret_cast<const double*>(src + n));
+        __m128d w = _mm_shuffle_pd(v, v, 1);
+        __m128d r = _mm_add_pd(_mm_mul_pd(csv, v), _mm_xor_pd(_mm_mul_pd(snv, w), sign));
+        r = _mm_add_pd(r, off);
+
+        __m128d nan = _mm_cmpunord_pd(v, v);
+        nan = _mm_or_pd(nan, _mm_shuffle_pd(nan, nan, 1));
+        _mm_storeu_pd(reinterpret_cast<double*>(dest + n), _mm_blendv_pd(r, v, nan));
+    }
+}
+
+//---------------------------------------------------------------------------
+// AVX2
+//---------------------------------------------------------------------------
+TARGET_AVX2
+void integrateAvx2(PairXy *position, PairXy *velocity,
+    const PairXy *nextVelocity, std::size_t count)
+{
+    double *p = reinterpret_cast<double*>(position);
+    double *v = reinterpret_cast<double*>(velocity);
+    const double *nv = reinterpret_cast<const double*>(nextVelocity);
+
+    // Two PairXy per register
+    std::size_t total = 2 * count;
+    std::size_t n = 0;
+
+    for(; n + 4 <= total; n += 4)
+    {
+        __m256d a = _mm256_loadu_pd(nv + n);
+        _mm256_storeu_pd(v + n, a);
+        _mm256_storeu_pd(p + n, _mm256_add_pd(_mm256_loadu_pd(p + n), a));
+    }
+
+    if (n < total)
+    {
+        integrateScalar(position + n / 2, velocity + n / 2, nextVelocity + n / 2, 1);
+    }
+}
+
+TARGET_AVX2
+void wrapAvx2(PairXy *position, const Real *radius, const EntityKind *kind,
+    std::size_t count, const WrapBounds &bounds)
+{
+    const __m256d sign = _mm256_set1_pd(-0.0);
+    const __m256d ext = _mm256_set_pd(bounds.extent.y(), bounds.extent.x(),
+        bounds.extent.y(), bounds.extent.x());
+
+    std::size_t n = 0;
+
+    for(; n + 2 <= count; n += 2)
+    {
+        Real m0x, m0y, m1x, m1y;
+        margins(radius, kind, n, bounds, m0x, m0y);
+        margins(radius, kind, n + 1, bounds, m1x, m1y);
+
+        __m256d m = _mm256_set_pd(m1y, m1x, m0y, m0x);
+        __m256d lo = _mm256_xor_pd(m, sign);
+        __m256d hi = _mm256_add_pd(ext, m);
+
+        double *p = reinterpret_cast<double*>(position + n);
+        __m256d v = _mm256_loadu_pd(p);
+
+        __m256d r = _mm256_blendv_pd(v, lo, _mm256_cmp_pd(v, hi, _CMP_GT_OQ));
+        r = _mm256_blendv_pd(r, hi, _mm256_cmp_pd(v, lo, _CMP_LT_OQ));
+        _mm256_storeu_pd(p, r);
+    }
+
+    wrapFrom(position, radius, kind, n, count, bounds);
+}
+
+TARGET_AVX2
+void transformAvx2(const PairXy *src, PairXy *dest, std::size_t count,
+    Real cs, Real sn, const PairXy &offset)
+{
+    const __m256d csv = _mm256_set1_pd(cs);
+    const __m256d snv = _mm256_set1_pd(sn);
+    const __m256d sign = _mm256_set_pd(0.0, -0.0, 0.0, -0.0);
+    const __m256d off = _mm256_set_pd(offset.y(), offset.x(), offset.y(), offset.x());
+
+    std::size_t n = 0;
+
+    for(; n + 2 <= count; n += 2)
+    {
+        __m256d v = _mm256_loadu_pd(reinterpret_cast<const double*>(src + n));
+        __m256d w = _mm256_permute_pd(v, 0x5);
+        __m256d r = _mm256_add_pd(_mm256_mul_pd(csv, v),
+            _mm256_xor_pd(_mm256_mul_pd(snv, w), sign));
+        r = _mm256_add_pd(r, off);
+
+        __m256d nan = _mm256_cmp_pd(v, v, _CMP_UNORD_Q);
+        nan = _mm256_or_pd(nan, _mm256_permute_pd(nan, 0x5));
+        _mm256_storeu_pd(reinterpret_cast<double*>(dest + n), _mm256_blendv_pd(r, v, nan));
+    }
+
+    transformScalar(src + n, dest + n, count - n, cs, sn, offset);
+}
+
+//---------------------------------------------------------------------------
+// AVX-512
+//---------------------------------------------------------------------------
+TARGET_AVX512
+void integrateAvx512(PairXy *position, PairXy *velocity,
+    const PairXy *nextVelocity, std::size_t count)
+{
+    double *p = reinterpret_cast<double*>(position);
+    double *v = reinterpret_cast<double*>(velocity);
+    const double *nv = reinterpret_cast<const double*>(nextVelocity);
+
+    // Four PairXy per register, with remainder masked
+    std::size_t total = 2 * count;
+
+    for(std::size_t n = 0; n < total; n += 8)
+    {
+        __mmask8 k = total - n >= 8 ? 0xFF : static_cast<__mmask8>((1u << (total - n)) - 1);
+        __m512d a = _mm512_maskz_loadu_pd(k, nv + n);
+        _mm512_mask_storeu_pd(v + n, k, a);
+        _mm512_mask_storeu_pd(p + n, k, _mm512_add_pd(_mm512_maskz_loadu_pd(k, p + n), a));
+    }
+}
+
+TARGET_AVX512
+void wrapAvx512(PairXy *position, const Real *radius, const EntityKind *kind,
+    std::size_t count, const WrapBounds &bounds)
+{
+    const __m512i sign = _mm512_castpd_si512(_mm512_set1_pd(-0.0));
+    const __m512d ext = _mm512_set_pd(bounds.extent.y(), bounds.extent.x(),
+        bounds.extent.y(), bounds.extent.x(), bounds.extent.y(), bounds.extent.x(),
+        bounds.extent.y(), bounds.extent.x());
+
+    std::size_t n = 0;
+
+    for(; n + 4 <= count; n += 4)
+    {
+        Real m0x, m0y, m1x, m1y, m2x, m2y, m3x, m3y;
+        margins(radius, kind, n, bounds, m0x, m0y);
+        margins(radius, kind, n + 1, bounds, m1x, m1y);
+        margins(radius, kind, n + 2, bounds, m2x, m2y);
+        margins(radius, kind, n + 3, bounds, m3x, m3y);
+
+        __m512d mv = _mm512_set_pd(m3y, m3x, m2y, m2x, m1y, m1x, m0y, m0x);
+        __m512d lo = _mm512_castsi512_pd(_mm512_xor_si512(_mm512_castpd_si512(mv), sign));
+        __m512d hi = _mm512_add_pd(ext, mv);
+
+        double *p = reinterpret_cast<double*>(position + n);
+        __m512d v = _mm512_loadu_pd(p);
+
+        __m512d r = _mm512_mask_blend_pd(_mm512_cmp_pd_mask(v, hi, _CMP_GT_OQ), v, lo);
+        r = _mm512_mask_blend_pd(_mm512_cmp_pd_mask(v, lo, _CMP_LT_OQ), r, hi);
+        _mm512_storeu_pd(p, r);
+    }
+
+    wrapFrom(position, radius, kind, n, count, bounds);
+}
+
+TARGET_AVX512
+void transformAvx512(const PairXy *src, PairXy *dest, std::size_t count,
+    Real cs, Real sn, const PairXy &offset)
+{
+    const __m512d csv = _mm512_set1_pd(cs);
+    const __m512d snv = _mm512_set1_pd(sn);
+    const __m512d off = _mm512_set_pd(offset.y(), offset.x(), offset.y(), offset.x(),
+        offset.y(), offset.x(), offset.y(), offset.x());
+    const __m512i sign = _mm512_castpd_si512(_mm512_set_pd(0.0, -0.0, 0.0, -0.0,
+        0.0, -0.0, 0.0, -0.0));
+
+    const double *s = reinterpret_cast<const double*>(src);
+    double *d = reinterpret_cast<double*>(dest);
+    std::size_t total = 2 * count;
+
+    for(std::size_t n = 0; n < total; n += 8)
+    {
+        __mmask8 k = total - n >= 8 ? 0xFF : static_cast<__mmask8>((1u << (total - n)) - 1);
+        __m512d v = _mm512_maskz_loadu_pd(k, s + n);
+        __m512d w = _mm512_mask_permute_pd(v, 0xFF, v, 0x55);
+        __m512d b = _mm512_castsi512_pd(_mm512_xor_si512(
+            _mm512_castpd_si512(_mm512_mul_pd(snv, w)), sign));
+        __m512d r = _mm512_add_pd(_mm512_add_pd(_mm512_mul_pd(csv, v), b), off);
+
+        // Mask of both lanes of points with either lane NaN
+        unsigned nan = _mm512_cmp_pd_mask(v, v, _CMP_UNORD_Q);
+        nan |= ((nan & 0x55u) << 1) | ((nan & 0xAAu) >> 1);
+        _mm512_mask_storeu_pd(d + n, k, _mm512_mask_blend_pd(static_cast<__mmask8>(nan), r, v));
+    }
+}
+
+#if defined(GATHER_SIZE_T)
+TARGET_AVX512
+std::size_t overlapAvx512(const PairXy *position, const Real *radius, const Real *mass,
+    std::size_t self, const std::size_t *index, std::size_t count, std::size_t *dest)
+{
+    const double *p = reinterpret_cast<const double*>(position);
+    const __m512d sx = _mm512_set1_pd(position[self].x());
+    const __m512d sy = _mm512_set1_pd(position[self].y());
+    const __m512d sr = _mm512_set1_pd(radius[self]);
+    const __m512d zero = _mm512_setzero_pd();
+    const __m512d margin = _mm512_set1_pd(OverlapMargin);
+
+    std::size_t hits = 0;
+
+    // Eight slots per register, with remainder masked
+    for(std::size_t n = 0; n < count; n += 8)
+    {
+        __mmask8 k = count - n >= 8 ? 0xFF : static_cast<__mmask8>((1u << (count - n)) - 1);
+        __m512i ix = _mm512_maskz_loadu_epi64(k, index + n);
+        __m512i ip = _mm512_add_epi64(ix, ix);
+
+        __m512d dx = _mm512_sub_pd(sx, _mm512_mask_i64gather_pd(zero, k, ip, p, 8));
+        __m512d dy = _mm512_sub_pd(sy, _mm512_mask_i64gather_pd(zero, k, ip, p + 1, 8));
+        __m512d r = _mm512_add_pd(sr, _mm512_mask_i64gather_pd(zero, k, ix, radius, 8));
+        __m512d d = _mm512_add_pd(_mm512_mul_pd(dx, dx), _mm512_mul_pd(dy, dy));
+
+        k = _mm512_mask_cmp_pd_mask(k, d, _mm512_mul_pd(_mm512_mul_pd(r, r), margin), _CMP_LE_OQ);
+        k = _mm512_mask_cmp_pd_mask(k, _mm512_mask_i64gather_pd(zero, k, ix, mass, 8),
+            zero, _CMP_GT_OQ);
+
+        _mm512_mask_compressstoreu_epi64(dest + hits, k, ix);
+        hits += bitCount(k);
+    }
+
+    return hits;
+}
+#endif
+#endif
+
+//---------------------------------------------------------------------------
+// BINDINGS
+//---------------------------------------------------------------------------
+const SimdKernels ScalarKernels = {integrateScalar, wrapScalar, transformScalar, overlapScalar};
+
+#if defined(GAME_SIMD_X86)
+// Overlap gathers slots by index. Gathers of AVX2 are no faster than
+// scalar, and masked compress stores are only in AVX-512.
+const SimdKernels Sse2Kernels = {integrateSse2, wrapSse2, transformSse2, overlapScalar};
+const SimdKernels Sse42Kernels = {integrateSse2, wrapSse42, transformSse42, overlapScalar};
+
+const SimdKernels Avx2Kernels = {integrateAvx2, wrapAvx2, transformAvx2, overlapScalar};
+
+#if defined(GATHER_SIZE_T)
+const SimdKernels Avx512Kernels = {integrateAvx512, wrapAvx512, transformAvx512, overlapAvx512};
+#else
+const SimdKernels Avx512Kernels = {integrateAvx512, wrapAvx512, transformAvx512, overlapScalar};
+#endif
+#endif
+
+} // namespace
+
+//---------------------------------------------------------------------------
+// NON-CLASS FUNCTIONS
+//---------------------------------------------------------------------------
+const SimdKernels& Game::Internal::kernels(SimdLevel level)
+{
+#if defined(GAME_SIMD_X86)
+    if (simdSupported(level))
+    {
+        switch(level)
+        {
+        case SimdLevel::Sse2: return Sse2Kernels;
+        case SimdLevel::Sse42: return Sse42Kernels;
+        case SimdLevel::Avx2: return Avx2Kernels;
+        case SimdLevel::Avx512: return Avx512Kernels;
+        default: break;
+        }
+    }
+#else
+    (void)level;
+#endif
+
+    return ScalarKernels;
+}
@@ -0,0 +1,74 @@
+//---------------------------------------------------------------------------
+// PROJECT      : Asteroid Style Game
+// COPYRIGHT    : Andy Thomas (C) 2019
+// WEB URL      : https://kuiper.zone
+// LICENSE      : GPLv3
+//---------------------------------------------------------------------------
+
+#ifndef GAME_SIMD_KERNELS_H
+#define GAME_SIMD_KERNELS_H
+
+#include "../pair_xy.h"
+#include "entity_kind.h"
+#include "simd.h"
+
+#include <cstddef>
+#include <cstdint>
+
+namespace Game { namespace Internal {
+
+//! Bounds of the toroidal wrap. Entities of a kind in deepKinds, a bit mask
+//! indexed by EntityKind, may roam the Kuiper zone beyond each edge of the
+//! extent. Others wrap once beyond the edge by their radius.
+struct WrapBounds
+{
+    PairXy extent;
+    PairXy kuiper;
+    std::uint32_t deepKinds {0};
+};
+
+//! Factor applied to the squared sum of radii by the overlap kernel. The
+//! squared test serves only to reject, where contact is decided by abs(),
+//! and r * r and sqrt() round differently at the boundary. The margin
+//! ensures that no pair for which abs() <= r is rejected, for any Real.
+const double OverlapMargin = 1.0 + 1.0 / 1024;
+
+//! Hot loops over entity store columns and polygons, with an implementation
+//! for each SimdLevel. Results are identical for any level, as each performs
+//! the same floating point operations in the same order. The best
+//! implementation of each is bound by kernels().
+struct SimdKernels
+{
+    //! Sets velocity to next velocity, and adds velocity to position, for
+    //! count slots.
+    void (*integrate)(PairXy *position, PairXy *velocity,
+        const PairXy *nextVelocity, std::size_t count);
+
+    //! Wraps each position in count slots, as described by WrapBounds. Where
+    //! a coordinate is less than -margin, it is set to extent + margin, or
+    //! where greater than extent + margin, it is set to -margin.
+    void (*wrap)(PairXy *position, const Real *radius, const EntityKind *kind,
+        std::size_t count, const WrapBounds &bounds);
+
+    //! Writes count points of src to dest, rotated by the cosine and sine
+    //! of an angle, as PairXy::rotate(), then translated by offset. NaN
+    //! points are copied unchanged.
+    void (*transform)(const PairXy *src, PairXy *dest, std::size_t count,
+        Real cs, Real sn, const PairXy &offset);
+
+    //! Writes to dest those of count slot indices which have mass and may
+    //! be in contact with the slot self, in order, and returns their number.
+    //! These are those for which squared distance is no greater than squared
+    //! sum of radii times OverlapMargin, so that all in contact, as decided
+    //! by Universe, are included. Dest must have room for count values.
+    std::size_t (*overlap)(const PairXy *position, const Real *radius, const Real *mass,
+        std::size_t self, const std::size_t *index, std::size_t count, std::size_t *dest);
+};
+
+//! Returns the kernels bound for level, which are Scalar where level is not
+//! supported. Not all levels have their own implementation of each kernel,
+//! in which case that of the nearest lower level is bound.
+const SimdKernels& kernels(SimdLevel level);
+
+}} // namespace
+#endif
@@ -16,9 +16,9 @@ using namespace Game::Internal;
 // CLASS SmallRock : PUBLIC MEMBERS
 //---------------------------------------------------------------------------
 SmallRock::SmallRock(Universe *owner)
-    : Rotator(owner)
+    : Rotator(owner, EntityKind::SmallRock)
 {
-    setPolygon(10.0);
+    setShape();
     setFragility(0.3);
     setFragmentKind(EntityKind::Debris);
     setFragmentCount(3);
@@ -14,16 +14,11 @@ namespace Game { namespace Internal {
 
 //! A concrete small rock class.  Derived from Rotator and fragments into
 //! debris when it explodes.
-class SmallRock : public Rotator
+class SmallRock final : public Rotator
 {
 public:
 
     SmallRock(Universe *owner);
-
-    // Overrides
-    EntityKind kind() const override { return EntityKind::SmallRock; }
-    int score() const override { return 25; };
-    double mass() const override { return 75; }
 };
 
 }} // namespace
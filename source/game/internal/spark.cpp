@@ -14,13 +14,9 @@ using namespace Game::Internal;
 // CLASS Spark : PUBLIC MEMBERS
 //---------------------------------------------------------------------------
 Spark::Spark(Universe *owner)
-    : GameEntity(owner)
+    : GameEntity(owner, EntityKind::Spark)
 {
-    std::vector<PairXy> poly(2);
-    poly[0] = PairXy(0.0, 1.0);
-    poly[1] = PairXy(0.0, -1.0);
-
-    setPolygon(poly);
+    setShape();
     setMaxSeconds(owner->random(0.05, 0.15));
 }
 
@@ -13,15 +13,12 @@
 namespace Game { namespace Internal {
 
 //! A short-lived sparkle associated with ship exhaust.
-class Spark : public GameEntity
+class Spark final : public GameEntity
 {
 public:
 
     Spark(Universe *owner);
 
-    // Overrides
-    EntityKind kind() const override { return EntityKind::Spark; }
-
 private:
 
 };
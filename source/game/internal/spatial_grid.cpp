@@ -0,0 +1,131 @@
+//---------------------------------------------------------------------------
+// PROJECT      : Asteroid Style Game
+// COPYRIGHT    : Andy Thomas (C) 2019
+// WEB URL      : https://kuiper.zone
+// LICENSE      : GPLv3
+//---------------------------------------------------------------------------
+
+#include "spatial_grid.h"
+
+#include <cmath>
+#include <algorithm>
+
+using namespace Game;
+using namespace Game::Internal;
+
+//---------------------------------------------------------------------------
+// CLASS SpatialGrid : PUBLIC MEMBERS
+//---------------------------------------------------------------------------
+void SpatialGrid::reset(const PairXy &min, const PairXy &max, double cellSize)
+{
+    double w = std::max<double>(max.x() - min.x(), 1.0);
+    double h = std::max<double>(max.y() - min.y(), 1.0);
+
+    // Keep cell count bounded when items are small
+    _cellSize = std::max(cellSize, std::max(w, h) / MaxCells);
+    _cellSize = std::max(_cellSize, 1.0);
+
+    _x0 = min.x();
+    _y0 = min.y();
+    _cols = std::max(static_cast<int>(std::ceil(w / _cellSize)), 1);
+    _rows = std::max(static_cast<int>(std::ceil(h / _cellSize)), 1);
+
+    _itemCell.clear();
+    _cellItems.clear();
+    _cellStart.assign(static_cast<std::size_t>(_cols * _rows) + 1, 0);
+}
+
+void SpatialGrid::insert(std::size_t index, const PairXy &pos)
+{
+    if (_itemCell.size() <= index)
+    {
+        _itemCell.resize(index + 1, -1);
+    }
+
+    int cell = cellOf(pos);
+    _itemCell[index] = cell;
+    _cellStart[cell + 1] += 1;
+}
+
+void SpatialGrid::build()
+{
+    // Counting sort by cell. Items within a
+    // cell remain in ascending index order.
+    for(std::size_t n = 1; n < _cellStart.size(); ++n)
+    {
+        _cellStart[n] += _cellStart[n - 1];
+    }
+
+    _cellNext.assign(_cellStart.begin(), _cellStart.end() - 1);
+    _cellItems.resize(_cellStart.back());
+
+    for(std::size_t n = 0; n < _itemCell.size(); ++n)
+    {
+        if (_itemCell[n] >= 0)
+        {
+            _cellItems[_cellNext[_itemCell[n]]++] = n;
+        }
+    }
+}
+
+void SpatialGrid::query(std::size_t index, std::vector<std::size_t> &dest) const
+{
+    query(index, 0, dest);
+}
+
+void SpatialGrid::queryLater(std::size_t index, std::vector<std::size_t> &dest) const
+{
+    query(index, index + 1, dest);
+}
+
+std::size_t SpatialGrid::size() const
+{
+    return _itemCell.size();
+}
+
+//---------------------------------------------------------------------------
+// CLASS SpatialGrid : PRIVATE MEMBERS
+//---------------------------------------------------------------------------
+void SpatialGrid::query(std::size_t index, std::size_t first, std::vector<std::size_t> &dest) const
+{
+    dest.clear();
+
+    int cell = _itemCell[index];
+    int cx = cell % _cols;
+    int cy = cell / _cols;
+
+    int x0 = std::max(cx - 1, 0);
+    int x1 = std::min(cx + 1, _cols - 1);
+    int y0 = std::max(cy - 1, 0);
+    int y1 = std::min(cy + 1, _rows - 1);
+
+    for(int y = y0; y <= y1; ++y)
+    {
+        for(int x = x0; x <= x1; ++x)
+        {
+            int c = y * _cols + x;
+
+            for(std::size_t n = _cellStart[c]; n < _cellStart[c + 1]; ++n)
+            {
+                if (_cellItems[n] >= first && _cellItems[n] != index)
+                {
+                    dest.push_back(_cellItems[n]);
+                }
+            }
+        }
+    }
+
+    std::sort(dest.begin(), dest.end());
+}
+
+int SpatialGrid::cellOf(const PairXy &pos) const
+{
+    // Out of range (and NaN) values are clamped to an edge cell
+    double fx = (pos.x() - _x0) / _cellSize;
+    double fy = (pos.y() - _y0) / _cellSize;
+
+    int x = fx > 0 ? static_cast<int>(std::min(fx, static_cast<double>(_cols - 1))) : 0;
+    int y = fy > 0 ? static_cast<int>(std::min(fy, static_cast<double>(_rows - 1))) : 0;
+
+    return y * _cols + x;
+}
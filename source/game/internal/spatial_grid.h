@@ -0,0 +1,81 @@
+//---------------------------------------------------------------------------
+// PROJECT      : Asteroid Style Game
+// COPYRIGHT    : Andy Thomas (C) 2019
+// WEB URL      : https://kuiper.zone
+// LICENSE      : GPLv3
+//---------------------------------------------------------------------------
+
+#ifndef GAME_SPATIAL_GRID_H
+#define GAME_SPATIAL_GRID_H
+
+#include "../pair_xy.h"
+
+#include <vector>
+#include <cstddef>
+
+namespace Game { namespace Internal {
+
+//! A uniform grid used as a collision "broadphase". It is rebuilt every tick
+//! by calling reset(), followed by insert() for each item and then build().
+//! Thereafter, query() yields the items in the same or neighbouring cells of
+//! a given item. Provided the cell size is no smaller than the greatest
+//! interaction distance, query() will return every item which may be in
+//! contact. Items outside the grid area are held in the nearest edge cell.
+//! Note that neighbours do not wrap around the grid edges, as collisions
+//! do not occur across the toroidal seam of the universe.
+class SpatialGrid
+{
+public:
+
+    //! Maximum number of cells along either axis.
+    static const int MaxCells = 256;
+
+    //! Clears the grid and sizes it to cover the area between min and max
+    //! with square cells. The cell size will be increased if needed to
+    //! keep the cell count within MaxCells along each axis.
+    void reset(const PairXy &min, const PairXy &max, double cellSize);
+
+    //! Inserts an item with the given index and position. Items are expected
+    //! to be inserted in ascending index order, starting from 0.
+    void insert(std::size_t index, const PairXy &pos);
+
+    //! Builds the cell lists. Must be called after inserting items and
+    //! before calling query().
+    void build();
+
+    //! Appends to dest the indices of items in the same or neighbouring cells
+    //! of the item index, excluding index itself. The result is sorted in
+    //! ascending order. The dest vector is cleared on entry.
+    void query(std::size_t index, std::vector<std::size_t> &dest) const;
+
+    //! As query(), but yields only items of greater index than index, so
+    //! that each pair of neighbours is found once only.
+    void queryLater(std::size_t index, std::vector<std::size_t> &dest) const;
+
+    //! The number of items inserted since reset().
+    std::size_t size() const;
+
+private:
+
+    double _cellSize {1};
+    double _x0 {0};
+    double _y0 {0};
+    int _cols {1};
+    int _rows {1};
+
+    // Cell number of each item
+    std::vector<int> _itemCell;
+
+    // Items ordered by cell, with start offsets
+    std::vector<std::size_t> _cellItems;
+    std::vector<std::size_t> _cellStart;
+    std::vector<std::size_t> _cellNext;
+
+    int cellOf(const PairXy &pos) const;
+
+    // Items in neighbouring cells of index, from first and excluding index
+    void query(std::size_t index, std::size_t first, std::vector<std::size_t> &dest) const;
+};
+
+}} // namespace
+#endif
@@ -0,0 +1,123 @@
+//---------------------------------------------------------------------------
+// PROJECT      : Asteroid Style Game
+// COPYRIGHT    : Andy Thomas (C) 2019
+// WEB URL      : https://kuiper.zone
+// LICENSE      : GPLv3
+//---------------------------------------------------------------------------
+
+#include "thread_pool.h"
+
+using namespace Game::Internal;
+
+//---------------------------------------------------------------------------
+// CLASS ThreadPool : PUBLIC MEMBERS
+//---------------------------------------------------------------------------
+ThreadPool::ThreadPool(int count)
+    : _next {0}
+{
+    // Calling thread makes up the count
+    for(int n = 1; n < count; ++n)
+    {
+        _threads.push_back(std::thread(&ThreadPool::loop, this));
+    }
+}
+
+ThreadPool::~ThreadPool()
+{
+    {
+        std::lock_guard<std::mutex> lock(_mutex);
+        _stopping = true;
+    }
+
+    _wake.notify_all();
+
+    for(std::size_t n = 0; n < _threads.size(); ++n)
+    {
+        _threads[n].join();
+    }
+}
+
+int ThreadPool::size() const
+{
+    return static_cast<int>(_threads.size()) + 1;
+}
+
+//---------------------------------------------------------------------------
+// CLASS ThreadPool : PRIVATE MEMBERS
+//---------------------------------------------------------------------------
+void ThreadPool::dispatch(int parts, Task task, void *context)
+{
+    if (parts <= 0)
+    {
+        return;
+    }
+
+    if (_threads.empty() || parts == 1)
+    {
+        // Nothing to share
+        for(int n = 0; n < parts; ++n)
+        {
+            task(context, n);
+        }
+
+        return;
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(_mutex);
+        _task = task;
+        _context = context;
+        _parts = parts;
+        _next = 0;
+        _busy = static_cast<int>(_threads.size());
+        _generation += 1;
+    }
+
+    _wake.notify_all();
+
+    // Caller works too
+    work();
+
+    std::unique_lock<std::mutex> lock(_mutex);
+    _done.wait(lock, [this] { return _busy == 0; });
+    _task = nullptr;
+}
+
+void ThreadPool::work()
+{
+    int part;
+
+    while((part = _next.fetch_add(1)) < _parts)
+    {
+        _task(_context, part);
+    }
+}
+
+void ThreadPool::loop()
+{
+    std::uint64_t seen = 0;
+
+    while(true)
+    {
+        {
+            std::unique_lock<std::mutex> lock(_mutex);
+            _wake.wait(lock, [this, seen] { return _stopping || _generation != seen; });
+
+            if (_stopping)
+            {
+                return;
+            }
+
+            seen = _generation;
+        }
+
+        work();
+
+        {
+            std::lock_guard<std::mutex> lock(_mutex);
+            _busy -= 1;
+        }
+
+        _done.notify_one();
+    }
+}
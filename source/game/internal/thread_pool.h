@@ -0,0 +1,79 @@
+//---------------------------------------------------------------------------
+// PROJECT      : Asteroid Style Game
+// COPYRIGHT    : Andy Thomas (C) 2019
+// WEB URL      : https://kuiper.zone
+// LICENSE      : GPLv3
+//---------------------------------------------------------------------------
+
+#ifndef GAME_THREAD_POOL_H
+#define GAME_THREAD_POOL_H
+
+#include <vector>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <atomic>
+#include <cstdint>
+
+namespace Game { namespace Internal {
+
+//! A minimal fork-join thread pool. The run() method divides work into a
+//! number of parts, which are processed by the pool threads together with
+//! the calling thread, and blocks until all parts are complete. The pool is
+//! intended to be driven by a single thread only.
+class ThreadPool
+{
+public:
+
+    //! Constructor. The count is the total number of threads to work on
+    //! each run() call, including the calling thread, and must be 1 or more.
+    explicit ThreadPool(int count);
+
+    //! Destructor. Joins pool threads.
+    ~ThreadPool();
+
+    //! The number of threads supplied to the constructor.
+    int size() const;
+
+    //! Calls func(part) for each part in [0, parts) using all threads, and
+    //! returns when all have completed. The order in which parts are processed
+    //! is not defined, so each must be independent of the others.
+    template <typename F>
+    void run(int parts, F &func)
+    {
+        dispatch(parts, &ThreadPool::call<F>, &func);
+    }
+
+private:
+
+    typedef void (*Task)(void *context, int part);
+
+    std::vector<std::thread> _threads;
+    std::mutex _mutex;
+    std::condition_variable _wake;
+    std::condition_variable _done;
+    std::uint64_t _generation {0};
+    bool _stopping {false};
+
+    Task _task {nullptr};
+    void *_context {nullptr};
+    int _parts {0};
+    int _busy {0};
+    std::atomic<int> _next;
+
+    ThreadPool(const ThreadPool&) = delete;
+    ThreadPool& operator=(const ThreadPool&) = delete;
+
+    template <typename F>
+    static void call(void *context, int part)
+    {
+        (*static_cast<F*>(context))(part);
+    }
+
+    void dispatch(int parts, Task task, void *context);
+    void work();
+    void loop();
+};
+
+}} // namespace
+#endif
@@ -13,21 +13,19 @@
 namespace Game { namespace Internal {
 
 //! The UFO.
-class Ufo : public Exploder
+class Ufo final : public Exploder
 {
 public:
 
     Ufo(Universe *owner);
 
-    // Overrides
-    EntityKind kind() const override { return EntityKind::Ufo; }
-    int score() const override { return 1000; }
-    double mass() const override { return 15; }
-    bool crunch(GameEntity *other) override;
-    bool advance() override;
+    // Hides Exploder
+    bool advance();
 
 private:
 
+    friend class Narrowphase;
+
     static const int MaxSpeed = 3;
 
     PairXy _thrustAngle {PairXy(1, 1)};
@@ -18,10 +18,13 @@
 #include "ufo.h"
 #include "bullet.h"
 #include "label.h"
+#include "entity_visit.h"
+#include "narrowphase.h"
+#include "thread_pool.h"
 
 #include <cmath>
 #include <cstdlib>
-#include <ctime>
+#include <cassert>
 #include <algorithm>
 
 using namespace Game;
@@ -30,15 +33,19 @@ using namespace Game::Internal;
 //---------------------------------------------------------------------------
 // CLASS Universe : PUBLIC MEMBERS
 //---------------------------------------------------------------------------
-Universe::Universe(ScaledCanvas *canvas)
-    : _canvas {canvas}
+Universe::Universe(ScaledCanvas *canvas, std::uint64_t seed)
+    : _canvas {canvas}, _seed {seed}
 {
-    _random.seed(static_cast<unsigned long>(std::time(0)));
+    _random.seed(_seed, PlayStream);
+    _shapeRandom.seed(_seed, ShapeStream);
+    _shapes.build(_shapeRandom);
+    setSimdLevel(simdDefault());
 }
 
 Universe::~Universe()
 {
     clear(0);
+    delete _pool;
     delete _canvas;
 }
 
@@ -47,6 +54,92 @@ ScaledCanvas* Universe::canvas() const
     return _canvas;
 }
 
+EntityStore& Universe::store()
+{
+    return _store;
+}
+
+const EntityStore& Universe::store() const
+{
+    return _store;
+}
+
+EntityStore& Universe::spawnBuffer()
+{
+    return _spawn;
+}
+
+EntityArena& Universe::arena()
+{
+    return _arena;
+}
+
+std::vector<PairXy>& Universe::drawBuffer()
+{
+    return _drawBuffer;
+}
+
+std::uint64_t Universe::seed() const
+{
+    return _seed;
+}
+
+const Universe::Settings& Universe::settings() const
+{
+    return _settings;
+}
+
+void Universe::setSettings(const Settings &settings)
+{
+    _settings = settings;
+}
+
+bool Universe::profiling() const
+{
+    return _profiling;
+}
+
+void Universe::setProfiling(bool on)
+{
+    _profiling = on;
+}
+
+int Universe::threadCount() const
+{
+    return _pool != nullptr ? _pool->size() : 1;
+}
+
+void Universe::setThreadCount(int count)
+{
+    if (count != threadCount())
+    {
+        delete _pool;
+        _pool = nullptr;
+
+        if (count > 1)
+        {
+            _pool = new ThreadPool(count);
+        }
+    }
+}
+
+SimdLevel Universe::simdLevel() const
+{
+    return _simdLevel;
+}
+
+void Universe::setSimdLevel(SimdLevel level)
+{
+    _simdLevel = simdSupported(level) ? level : simdDetected();
+    _kernels = &Internal::kernels(_simdLevel);
+    _canvas->setKernels(*_kernels);
+}
+
+std::uint64_t Universe::newSerial()
+{
+    return _serial++;
+}
+
 void Universe::start(int lives)
 {
     clear(std::max(lives, 1));
@@ -97,8 +190,26 @@ Ship* Universe::ship() const
     return _ship;
 }
 
+Ship* Universe::addShip()
+{
+    if (_ship == nullptr)
+    {
+        _ship = new (this) Ship(this);
+        add(_ship, Position::Center);
+    }
+
+    return _ship;
+}
+
 void Universe::advance()
 {
+    _stats = TickStats();
+    _advancing = true;
+    std::int64_t heapCount = _arena.heapCount();
+
+    std::chrono::steady_clock::time_point mark;
+    lap(mark);
+
     if (_startTick > 0 && _ticker > _startTick)
     {
         if (_lifeCount > 0)
@@ -113,83 +224,33 @@ void Universe::advance()
         }
     }
 
+    // Any removed outside of advance()
+    _store.compact();
+
     // Give every game object "knowledge" of every other object in the universe.
     // This allows for collisions, hits and UFO awareness behaviour.
-    std::size_t count = _entities.size();
-
-    for(std::size_t x = 0; x < count; ++x)
-    {
-        GameEntity *ex = _entities[x];
-
-        for(std::size_t y = 0; y < count; ++y)
-        {
-            if (x != y && ex->crunch(_entities[y]))
-            {
-                GameEntity *ey = _entities[y];
+    crunch();
+    _stats.crunchNs = lap(mark);
 
-                // Keep score
-                if (ey->kind() == EntityKind::Bullet && ex->score() > 0)
-                {
-                    incScore(ex->score());
-
-                    // Floating score label
-                    Label *lab = new Label(this, std::to_string(ex->score()));
-                    lab->setVelocity(ex->velocity());
-                    add(lab, ex->position());
-                }
-            }
-        }
-    }
+    // Motion of every entity
+    _kernels->integrate(_store.positionData(), _store.velocityData(),
+        _store.nextVelocityData(), _store.size());
 
+    _stats.integrateNs = lap(mark);
 
     // Advance state of every entity.
     int ufoCount = 0;
-    double cx = _canvas->width();
-    double cy = _canvas->height();
 
-    std::size_t n = 0;
-    while(n < _entities.size())
+    for(std::size_t n = 0; n < _store.size(); ++n)
     {
-        GameEntity *entity = _entities[n];
+        GameEntity *entity = _store.entity(n);
 
-        if (entity->advance())
+        if (advanceEntity(entity))
         {
-            // Move to next
-            n += 1;
-
             if (entity->kind() == EntityKind::Ufo)
             {
                 ufoCount += 1;
             }
-
-            // Toroidal space restricton
-            PairXy pos = entity->position();
-
-            if (isDeepRoaming(entity->kind()))
-            {
-                // Can roam in Kuiper zone
-                double kx = KuiperZone * cx;
-                double ky = KuiperZone * cy;
-
-                if (pos.x() < -kx) pos.setX(cx + kx);
-                else if (pos.x() > cx + kx) pos.setX(-kx);
-
-                if (pos.y() < -ky) pos.setY(cy + ky);
-                else if (pos.y() > cy + ky) pos.setY(-ky);
-            }
-            else
-            {
-                // Visible region only
-                double r = entity->radius();
-
-                if (pos.x() < -r) pos.setX(cx + r);
-                else if (pos.x() > cx + r) pos.setX(-r);
-
-                if (pos.y() < -r) pos.setY(cy + r);
-                else if (pos.y() > cy + r) pos.setY(-r);
-            }
-
-            entity->setPosition(pos);
         }
         else
         {
@@ -203,7 +264,7 @@ void Universe::advance()
                     _startTick = _ticker + secondsToTicks(GameEndDelay);
                     _canvas->playSound(SoundId::IntroMusic, SoundOpt::None);
 
-                    Label *lab = new Label(this, "GAME OVER", -1);
+                    Label *lab = new (this) Label(this, "GAME OVER", -1);
                     lab->setRem(2);
                     add(lab, Position::Center);
                 }
@@ -213,39 +274,71 @@ void Universe::advance()
                 }
             }
 
-            // Remove if dead
-            delete entity;
-            _entities.erase(_entities.begin() + n);
+            // Remove if dead. This leaves a hole in the
+            // store, and all are removed together below.
+            destroy(entity);
         }
     }
 
+    _store.compact();
+    _stats.behaviourNs = lap(mark);
+
+    // Toroidal space restricton
+    wrap();
+    _stats.wrapNs = lap(mark);
+
     // Add new rock to game?
-    static const double RockRate = MaxRockPerSecond * PollInterval / 1000.0;
+    double rockRate = _settings.maxRockPerSecond * PollInterval / 1000.0;
 
-    if (random() < RockRate * tickFactor())
+    if (random() < rockRate * tickFactor())
     {
-        PairXy vel = randomXy(MaxRockSpeed * tickFactor());
-        add(new BigRock(this), Position::Kuiper)->setVelocity(vel);
+        PairXy vel = randomXy(_settings.maxRockSpeed * tickFactor());
+        add(new (this) BigRock(this), Position::Kuiper)->setVelocity(vel);
     }
 
     // Add Ufo to game?
-    static const double UfoRate = MaxUfoPerSecond * PollInterval / 1000.0;
+    double ufoRate = _settings.maxUfoPerSecond * PollInterval / 1000.0;
 
-    if (ufoCount < MaxUfoCount && random() < UfoRate)
+    if (ufoCount < _settings.maxUfoCount && random() < ufoRate)
     {
-        add(new Ufo(this), Position::Kuiper);
+        add(new (this) Ufo(this), Position::Kuiper);
     }
 
+    // New entities join in one batch. Each must have been added.
+    assert(_spawnAdded == _spawn.size() - _spawn.holes());
+    _store.merge(_spawn);
+    _spawnAdded = 0;
+    _advancing = false;
+    _stats.spawnNs = lap(mark);
+
+    _stats.heapAllocs = _arena.heapCount() - heapCount;
     _ticker += 1;
 }
 
 void Universe::draw()
 {
     _canvas->beginDraw();
+    _drawStats = DrawStats();
 
-    for(std::size_t x = 0; x < _entities.size(); ++x)
+    PairXy view(_canvas->width(), _canvas->height());
+
+    for(std::size_t x = 0; x < _store.size(); ++x)
     {
-        _entities[x]->draw();
+        GameEntity *entity = _store.entity(x);
+
+        // Skip holes, and cull those out of view
+        // before any work is done on their outline
+        if (entity != nullptr)
+        {
+            if (drawEntity(entity, view))
+            {
+                _drawStats.drawn += 1;
+            }
+            else
+            {
+                _drawStats.culled += 1;
+            }
+        }
     }
 
     double cx = _canvas->width();
@@ -271,19 +364,29 @@ void Universe::draw()
     _canvas->endDraw();
 }
 
+const Universe::TickStats& Universe::tickStats() const
+{
+    return _stats;
+}
+
+const Universe::DrawStats& Universe::drawStats() const
+{
+    return _drawStats;
+}
+
 GameEntity* Universe::create(EntityKind kind)
 {
     switch (kind)
     {
-    case EntityKind::Ship: return new Ship(this);
-    case EntityKind::BigRock: return new BigRock(this);
-    case EntityKind::MediumRock: return new MediumRock(this);
-    case EntityKind::SmallRock: return new SmallRock(this);
-    case EntityKind::Bullet: return new Bullet(this);
-    case EntityKind::Debris: return new Debris(this);
-    case EntityKind::Spark: return new Spark(this);
+    case EntityKind::Ship: return new (this) Ship(this);
+    case EntityKind::BigRock: return new (this) BigRock(this);
+    case EntityKind::MediumRock: return new (this) MediumRock(this);
+    case EntityKind::SmallRock: return new (this) SmallRock(this);
+    case EntityKind::Bullet: return new (this) Bullet(this);
+    case EntityKind::Debris: return new (this) Debris(this);
+    case EntityKind::Spark: return new (this) Spark(this);
     case EntityKind::Ufo: return nullptr;
-    case EntityKind::Label: return new Label(this);
+    case EntityKind::Label: return new (this) Label(this);
     default: return nullptr;
     }
 }
@@ -291,7 +394,15 @@ GameEntity* Universe::create(EntityKind kind)
 GameEntity* Universe::add(GameEntity *entity, const PairXy& pos)
 {
     entity->setPosition(pos);
-    _entities.push_back(entity);
+    _spawnAdded += 1;
+
+    if (!_advancing)
+    {
+        assert(_spawnAdded == _spawn.size() - _spawn.holes());
+        _store.merge(_spawn);
+        _spawnAdded = 0;
+    }
+
     return entity;
 }
 
@@ -361,14 +472,28 @@ GameEntity* Universe::add(GameEntity *entity, Position pos)
 
 double Universe::random() const
 {
-    std::uniform_real_distribution<double> unif(0.0, 1.0);
-    return unif(_random);
+    return _random.real();
 }
 
 double Universe::random(double min, double max) const
 {
-    std::uniform_real_distribution<double> unif(min, max);
-    return unif(_random);
+    return _random.real(min, max);
+}
+
+double Universe::random(const GameEntity *a, const GameEntity *b) const
+{
+    return Random::toReal(Random::hash(_seed ^ Random::hash(static_cast<std::uint64_t>(_ticker)
+        ^ Random::hash(a->serial() ^ Random::hash(b->serial())))));
+}
+
+double Universe::shapeRandom(double min, double max) const
+{
+    return _shapeRandom.real(min, max);
+}
+
+const ShapeLibrary& Universe::shapes() const
+{
+    return _shapes;
 }
 
 //---------------------------------------------------------------------------
@@ -376,15 +501,297 @@ double Universe::random(double min, double max) const
 //---------------------------------------------------------------------------
 void Universe::clear(int lives)
 {
-    for(std::size_t x = 0; x < _entities.size(); ++x)
+    for(std::size_t x = 0; x < _store.size(); ++x)
     {
-        delete _entities[x];
+        destroy(_store.entity(x));
     }
 
+    for(std::size_t x = 0; x < _spawn.size(); ++x)
+    {
+        destroy(_spawn.entity(x));
+    }
+
+    _store.compact();
+    _spawn.compact();
+    _spawnAdded = 0;
+
     _lifeCount = lives;
     _startTick = 0;
     _ship = nullptr;
-    _entities.clear();
+}
+
+void Universe::crunch()
+{
+    // Ghost kinds take no part, so are left out of the
+    // broadphase and the iteration of collision parts.
+    _solid.clear();
+    Real maxRadius = 0;
+
+    for(std::size_t n = 0; n < _store.size(); ++n)
+    {
+        if (contactMask(_store.kind(n)) != 0)
+        {
+            _solid.push_back(n);
+            maxRadius = std::max(maxRadius, _store.radius(n));
+        }
+    }
+
+    // Rebuild broadphase. Cells must be no smaller than the greatest
+    // contact distance. The grid covers the kuiper zone, where anything
+    // beyond it (not yet wrapped) is held in the edge cells. Grid items
+    // are indices of _solid.
+    std::size_t count = _solid.size();
+    PairXy kuiper = kuiperMargin();
+    PairXy extent(_canvas->width(), _canvas->height());
+    _grid.reset(PairXy() - kuiper, extent + kuiper, 2.0 * maxRadius);
+
+    for(std::size_t n = 0; n < count; ++n)
+    {
+        _grid.insert(n, _store.position(_solid[n]));
+    }
+
+    _grid.build();
+
+    // Slots of kinds which react at a distance, i.e. UFOs
+    _sighted.clear();
+
+    for(std::size_t n = 0; n < count; ++n)
+    {
+        if (sightMask(_store.kind(_solid[n])) != 0)
+        {
+            _sighted.push_back(_solid[n]);
+        }
+    }
+
+    // Divide into parts which may run concurrently. Each part finds the
+    // pairs of the slots in its own range, and writes no entity state.
+    std::size_t threads = _pool != nullptr ? _pool->size() : 1;
+    std::size_t parts = threads > 1 ? std::min(threads * 4, count) : 1;
+    parts = std::max(parts, static_cast<std::size_t>(1));
+
+    if (_parts.size() < parts)
+    {
+        _parts.resize(parts);
+    }
+
+    for(std::size_t n = 0; n < parts; ++n)
+    {
+        _parts[n].begin = count * n / parts;
+        _parts[n].end = count * (n + 1) / parts;
+    }
+
+    auto func = [this](int n) { crunch(_parts[n]); };
+
+    if (_pool != nullptr)
+    {
+        _pool->run(static_cast<int>(parts), func);
+    }
+    else
+    {
+        func(0);
+    }
+
+    // Responses of both entities of each pair, in order of the first slot
+    // of the pair, then the second. Each entity therefore sees its partners
+    // in ascending slot order, as though each reacted to all others in turn.
+    _scored.clear();
+
+    for(std::size_t n = 0; n < parts; ++n)
+    {
+        CrunchPart &part = _parts[n];
+        _stats.pairsTested += part.pairsTested;
+
+        for(std::size_t p = 0; p < part.pairs.size(); ++p)
+        {
+            const CrunchPair &pair = part.pairs[p];
+            crunch(pair.x, pair.y, pair.contact);
+            crunch(pair.y, pair.x, pair.contact.mirrored());
+        }
+    }
+
+    // Scores in entity order
+    std::sort(_scored.begin(), _scored.end());
+
+    for(std::size_t s = 0; s < _scored.size(); ++s)
+    {
+        GameEntity *ex = _store.entity(_scored[s]);
+        incScore(ex->score());
+
+        // Floating score label
+        Label *lab = new (this) Label(this, std::to_string(ex->score()));
+        lab->setVelocity(ex->velocity());
+        add(lab, ex->position());
+    }
+}
+
+void Universe::crunch(CrunchPart &part)
+{
+    part.pairs.clear();
+    part.pairsTested = 0;
+
+    for(std::size_t s = part.begin; s < part.end; ++s)
+    {
+        std::size_t x = _solid[s];
+        EntityKind kind = _store.kind(x);
+
+        if (sightMask(kind) != 0)
+        {
+            // Reacts to kinds in sight at any distance, so is
+            // paired with every later slot
+            for(std::size_t n = s + 1; n < _solid.size(); ++n)
+            {
+                pair(part, x, _solid[n]);
+            }
+
+            part.pairsTested += _solid.size() - s - 1;
+            continue;
+        }
+
+        // Later slots nearby, in ascending order
+        _grid.queryLater(s, part.neighbours);
+
+        std::uint32_t mask = contactMask(kind);
+        std::size_t ncount = 0;
+
+        for(std::size_t n = 0; n < part.neighbours.size(); ++n)
+        {
+            std::size_t y = _solid[part.neighbours[n]];
+
+            if ((mask & kindBit(_store.kind(y))) != 0)
+            {
+                part.neighbours[ncount++] = y;
+            }
+        }
+
+        // Distant entities are rejected before pairing, which decides contact,
+        // with the overlap kernel testing all neighbours at once
+        part.pairsTested += ncount;
+        part.contacts.resize(ncount);
+        ncount = _kernels->overlap(_store.positionData(), _store.radiusData(),
+            _store.massData(), x, part.neighbours.data(), ncount, part.contacts.data());
+        part.contacts.resize(ncount);
+
+        // Later slots which see x at any distance
+        bool seen = false;
+
+        for(std::size_t n = 0; n < _sighted.size(); ++n)
+        {
+            std::size_t y = _sighted[n];
+
+            if (y > x && sees(_store.kind(y), kind))
+            {
+                part.contacts.push_back(y);
+                part.pairsTested += 1;
+                seen = true;
+            }
+        }
+
+        if (seen)
+        {
+            std::sort(part.contacts.begin(), part.contacts.end());
+            part.contacts.erase(std::unique(part.contacts.begin(), part.contacts.end()),
+                part.contacts.end());
+        }
+
+        for(std::size_t n = 0; n < part.contacts.size(); ++n)
+        {
+            pair(part, x, part.contacts[n]);
+        }
+    }
+}
+
+void Universe::pair(CrunchPart &part, std::size_t x, std::size_t y) const
+{
+    // Geometry of the pair, as seen from x. Squared values only reject,
+    // with margin, to avoid sqrt where there is no contact. Contact is
+    // decided by abs(), as r * r and sqrt() round differently.
+    GameEntity::Contact contact;
+    contact.offset = _store.position(x) - _store.position(y);
+
+    double r = _store.radius(x) + _store.radius(y);
+    bool near = contact.offset.absSquared() <= r * r * OverlapMargin;
+    bool sight = sees(_store.kind(x), _store.kind(y)) || sees(_store.kind(y), _store.kind(x));
+
+    if (!near && !sight)
+    {
+        return;
+    }
+
+    contact.distance = contact.offset.abs();
+    contact.touching = near && contact.distance <= r;
+
+    if (!contact.touching && !sight)
+    {
+        return;
+    }
+
+    contact.approaching = contact.touching && contact.distance
+        > (contact.offset + (_store.velocity(x) - _store.velocity(y)) * 0.1).abs();
+
+    part.pairs.push_back(CrunchPair {x, y, contact});
+}
+
+void Universe::crunch(std::size_t x, std::size_t y, const GameEntity::Contact &contact)
+{
+    // Response specialised for the pair of kinds,
+    // which is null where either is a ghost
+    Narrowphase::Handler handler = Narrowphase::handler(_store.kind(x), _store.kind(y));
+
+    if (handler == nullptr)
+    {
+        return;
+    }
+
+    GameEntity *ex = _store.entity(x);
+
+    if (handler(ex, _store.entity(y), contact))
+    {
+        _stats.pairsHit += 1;
+
+        // Keep score
+        if (_store.kind(y) == EntityKind::Bullet && ex->score() > 0)
+        {
+            _scored.push_back(x);
+        }
+    }
+}
+
+void Universe::wrap()
+{
+    WrapBounds bounds;
+    bounds.extent = PairXy(_canvas->width(), _canvas->height());
+    bounds.kuiper = kuiperMargin();
+
+    // Kinds which can roam in Kuiper zone. Others
+    // wrap at the edge of the visible region.
+    for(int k = 0; k <= static_cast<int>(EntityKind::Label); ++k)
+    {
+        if (isDeepRoaming(static_cast<EntityKind>(k)))
+        {
+            bounds.deepKinds |= 1u << k;
+        }
+    }
+
+    _kernels->wrap(_store.positionData(), _store.radiusData(),
+        _store.kindData(), _store.size(), bounds);
+}
+
+std::int64_t Universe::lap(std::chrono::steady_clock::time_point &mark) const
+{
+    if (_profiling)
+    {
+        auto now = std::chrono::steady_clock::now();
+        auto ns = std::chrono::duration_cast<std::chrono::nanoseconds>(now - mark).count();
+        mark = now;
+        return static_cast<std::int64_t>(ns);
+    }
+
+    return 0;
+}
+
+PairXy Universe::kuiperMargin() const
+{
+    return PairXy(KuiperZone * _canvas->width(), KuiperZone * _canvas->height());
 }
 
 void Universe::restart(int lives)
@@ -394,14 +801,13 @@ void Universe::restart(int lives)
     _canvas->playSound(SoundId::Start, SoundOpt::None);
 
     // Faster and more initial rocks when using lives
-    int count = StartRocks + StartRocks * _deathCount / 2;
-    double speed = MaxRockSpeed * (0.2 + static_cast<double>(_deathCount) / 10);
+    int count = _settings.startRocks + _settings.startRocks * _deathCount / 2;
+    double speed = _settings.maxRockSpeed * (0.2 + static_cast<double>(_deathCount) / 10);
 
     for(int n = 0; n < count; ++n)
     {
-        add(new BigRock(this), Position::Kuiper)->setVelocity(randomXy(speed));
+        add(new (this) BigRock(this), Position::Kuiper)->setVelocity(randomXy(speed));
     }
 
-    _ship = new Ship(this);
-    add(_ship, Position::Center);
+    addShip();
 }
@@ -11,11 +11,19 @@
 #include "../pair_xy.h"
 #include "../key_id.h"
 #include "entity_kind.h"
+#include "entity_store.h"
+#include "entity_arena.h"
+#include "game_entity.h"
+#include "collision_mask.h"
+#include "spatial_grid.h"
+#include "simd_kernels.h"
+#include "random.h"
+#include "shape_library.h"
 
 #include <vector>
 #include <string>
 #include <cstdint>
-#include <random>
+#include <chrono>
 
 namespace Game { namespace Internal {
 
@@ -23,6 +31,7 @@ namespace Game { namespace Internal {
 class GameEntity;
 class ScaledCanvas;
 class Ship;
+class ThreadPool;
 
 //! Maintains game objects, their interactions and core game logic. The start()
 //! method must called to initiate a game, and advance() must called every
@@ -45,10 +54,67 @@ public:
         Lower, //!< Added to the lower part of the screen.
     };
 
+    //! Performance counters pertaining to the last call to advance().
+    struct TickStats
+    {
+        //! Number of unordered entity pairs considered by the collision
+        //! phase, i.e. in neighbouring grid cells, or in view of a far-sighted
+        //! entity. Pairs involving ghost kinds are not considered.
+        std::int64_t pairsTested {0};
+
+        //! Number of pairs for which a Narrowphase handler returned true.
+        std::int64_t pairsHit {0};
+
+        //! Number of heap allocations made by the entity arena. This is
+        //! expected to be 0 once the game reaches a steady state.
+        std::int64_t heapAllocs {0};
+
+        //! Time spent in each phase of advance() in nanoseconds. These are
+        //! measured only if profiling() is true, and are otherwise 0.
+        std::int64_t crunchNs {0};
+        std::int64_t integrateNs {0};
+        std::int64_t behaviourNs {0};
+        std::int64_t wrapNs {0};
+        std::int64_t spawnNs {0};
+    };
+
+    //! Counters pertaining to the last call to draw().
+    struct DrawStats
+    {
+        //! Number of entities drawn.
+        std::int64_t drawn {0};
+
+        //! Number of entities not drawn as wholly beyond the visible region,
+        //! such as those in the Kuiper zone.
+        std::int64_t culled {0};
+    };
+
+    //! Parameters which govern the population of the universe. The defaults
+    //! are those of the game. Other values are intended for benchmarks.
+    struct Settings
+    {
+        //! Initial number of rocks.
+        int startRocks {12};
+
+        //! Maximum rock speed.
+        double maxRockSpeed {5};
+
+        //! Maximum number of UFOs at same time.
+        int maxUfoCount {4};
+
+        //! Maximum rate at which asteroids can be added to the universe.
+        double maxRockPerSecond {1.0};
+
+        //! Maximum rate at which UFOs can be added to the universe.
+        double maxUfoPerSecond {0.15};
+    };
+
     //! Constructor. The caller must supply an instance ScaledCanvas. This
     //! will be deleted by the class destructor. The start() method should
-    //! be called to initialise a new game.
-    Universe(ScaledCanvas *canvas);
+    //! be called to initialise a new game. Random numbers are generated
+    //! from the seed, so that universes constructed with the same seed,
+    //! and given the same input, play an identical game.
+    Universe(ScaledCanvas *canvas, std::uint64_t seed);
 
     //! Destructor.
     virtual ~Universe();
@@ -56,6 +122,60 @@ public:
     //! Returns the pointer to ScaledCanvas supplied to the constructor.
     ScaledCanvas* canvas() const;
 
+    //! Gets the store holding the physical state of entities in play.
+    EntityStore& store();
+    const EntityStore& store() const;
+
+    //! Gets the buffer which holds entities from construction until they are
+    //! merged into store(). Entities take a slot here when constructed, and
+    //! each must be passed to add() before the next merge. Entities added
+    //! during advance() are merged in a single batch at the end of the tick,
+    //! so they are not advanced in the tick in which they were created. Those
+    //! added at other times are merged immediately by add().
+    EntityStore& spawnBuffer();
+
+    //! Gets the arena from which entity instances are allocated.
+    EntityArena& arena();
+
+    //! Gets a scratch buffer of points for use by GameEntity::draw(), which
+    //! transforms its polygon here before drawing. It avoids an allocation
+    //! per entity per frame. Contents are not preserved between calls.
+    std::vector<PairXy>& drawBuffer();
+
+    //! The seed supplied to the constructor.
+    std::uint64_t seed() const;
+
+    //! Gets and sets population settings. Changes apply from the next call to
+    //! start() or advance().
+    const Settings& settings() const;
+    void setSettings(const Settings &settings);
+
+    //! Enables the timing of phases in tickStats(). The initial value is false.
+    bool profiling() const;
+    void setProfiling(bool on);
+
+    //! The number of threads used by the collision phase of advance(). The
+    //! outcome of the game is identical for any value. The initial value is 1,
+    //! where all work is done on the calling thread.
+    int threadCount() const;
+    void setThreadCount(int count);
+
+    //! The instruction set of the kernels used by advance() and entities.
+    //! The outcome of the game is identical for any value. The initial value
+    //! is simdDefault(). Unsupported levels are reduced to simdDetected().
+    SimdLevel simdLevel() const;
+    void setSimdLevel(SimdLevel level);
+
+    //! Kernels bound for simdLevel().
+    const SimdKernels& kernels() const
+    {
+        return *_kernels;
+    }
+
+    //! Returns a new value on each call, starting from 0. It is used
+    //! to give each entity a unique serial number on construction.
+    std::uint64_t newSerial();
+
     //! Starts a new game. If a game is in play, it is restarted.
     void start(int lives = 3);
 
@@ -82,16 +202,35 @@ public:
     //! check whether the value is null.
     Ship* ship() const;
 
+    //! Adds a new Ship at the center, which becomes ship(), and returns it.
+    //! It is called by start(), and may be called directly to stage a game
+    //! without start(), such as for benchmarking. Does nothing and returns
+    //! the existing instance where ship() is not null.
+    Ship* addShip();
+
     //! Advances the game state and increments ticker().
     void advance();
 
     //! Draws the game on the canvas() instance.
     void draw();
 
-    //! Creates an instance of the given entity kind. The universe state is unchanged.
+    //! Gets the performance counters of the last advance() call.
+    const TickStats& tickStats() const;
+
+    //! Gets the counters of the last draw() call.
+    const DrawStats& drawStats() const;
+
+    //! Creates an instance of the given entity kind, allocated from arena().
+    //! The instance takes a slot in spawnBuffer() on construction, so must be
+    //! passed to add() before any other add() outside advance(), or the end
+    //! of advance() if called during it. Returns null for EntityKind::Ufo.
     GameEntity* create(EntityKind kind);
 
-    //! Adds the entity to the universe. The entity pointer is returned as the result.
+    //! Adds the entity, which must be newly constructed, to the universe. The
+    //! entity pointer is returned as the result. If called during advance(),
+    //! the entity joins the game at the end of the tick. Otherwise, all of
+    //! spawnBuffer() is merged at once, so every entity constructed since the
+    //! last merge must have been added.
     GameEntity* add(GameEntity *entity, const PairXy& pos);
 
     //! Adds entity and sets both position and velocity.
@@ -101,13 +240,27 @@ public:
     //! The entity pointer is returned as the result.
     GameEntity* add(GameEntity *entity, Position pos);
 
-    //! Generates a pseudo random number in the range [0, 1.0]. The PRNG state
+    //! Generates a pseudo random number in the range [0, 1.0). The PRNG state
     //! is held by the Universe instance and seeded on construction.
     double random() const;
 
-    //! Generates a pseudo random number in the range [min, max].
+    //! Generates a pseudo random number in the range [min, max).
     double random(double min, double max) const;
 
+    //! Generates a pseudo random number in the range [0, 1.0) for the ordered
+    //! pair of entities. The value depends only on the seed, the current tick and
+    //! the serial numbers of a and b. It does not change the PRNG state, and may
+    //! be called concurrently within the collision phase of advance().
+    double random(const GameEntity *a, const GameEntity *b) const;
+
+    //! Generates a pseudo random number in the range [min, max) for cosmetic
+    //! use, such as the outline of shapes. It is drawn from a separate stream
+    //! so that it has no bearing on the sequence given by random().
+    double shapeRandom(double min, double max) const;
+
+    //! Outlines shared by entities, built on construction.
+    const ShapeLibrary& shapes() const;
+
     //! Maps seconds to game ticks.
     static inline std::int64_t secondsToTicks(double sec)
     {
@@ -126,21 +279,6 @@ private:
     // Used to determine rock generation rates and speeds etc.
     static const int MidDifficulty = 75;
 
-    // Initial number of rocks
-    static const int StartRocks = 12;
-
-    // Maximum rock speed.
-    static const int MaxRockSpeed = 5;
-
-    // Maximum number of UFOs at same time.
-    static const int MaxUfoCount = 4;
-
-    // Maximum rate at which asteroids can be added to the universe.
-    const double MaxRockPerSecond = 1.0;
-
-    // Maximum rate at which UFOs can be added to the universe.
-    const double MaxUfoPerSecond = 0.15;
-
     // A factor used to determine Kuiper region size.
     const double KuiperZone = 0.2;
 
@@ -153,12 +291,70 @@ private:
     std::int64_t _startTick {0};
     ScaledCanvas* _canvas;
     Ship *_ship {nullptr};
-    std::vector<GameEntity*> _entities;
+    EntityArena _arena;
+    EntityStore _store;
+    EntityStore _spawn;
+    std::size_t _spawnAdded {0};
+    std::vector<PairXy> _drawBuffer;
+    bool _advancing {false};
+
+    // A pair of slots, x < y, which may interact, with the
+    // contact geometry as seen from x
+    struct CrunchPair
+    {
+        std::size_t x;
+        std::size_t y;
+        GameEntity::Contact contact;
+    };
 
-    mutable std::ranlux24 _random;
+    // Per-part state of the collision phase
+    struct CrunchPart
+    {
+        std::size_t begin {0};
+        std::size_t end {0};
+        std::vector<std::size_t> neighbours;
+        std::vector<std::size_t> contacts;
+        std::vector<CrunchPair> pairs;
+        std::int64_t pairsTested {0};
+    };
+
+    // Collision broadphase, holding slots of solid kinds only
+    std::vector<std::size_t> _solid;
+    std::vector<std::size_t> _sighted;
+    std::vector<std::size_t> _scored;
+    SpatialGrid _grid;
+    std::vector<CrunchPart> _parts;
+    ThreadPool *_pool {nullptr};
+    TickStats _stats;
+    DrawStats _drawStats;
+    Settings _settings;
+    SimdLevel _simdLevel {SimdLevel::Scalar};
+    const SimdKernels *_kernels {nullptr};
+    bool _profiling {false};
+
+    std::uint64_t _seed {0};
+    std::uint64_t _serial {0};
+    // Random streams
+    static const std::uint64_t PlayStream = 0;
+    static const std::uint64_t ShapeStream = 1;
+    mutable Random _random;
+    mutable Random _shapeRandom;
+    ShapeLibrary _shapes;
 
     void clear(int lifeCount);
     void restart(int lifeCount);
+    void crunch();
+    void crunch(CrunchPart &part);
+    void pair(CrunchPart &part, std::size_t x, std::size_t y) const;
+    void crunch(std::size_t x, std::size_t y, const GameEntity::Contact &contact);
+    void wrap();
+
+    // Nanoseconds since mark, and resets mark to now. Returns 0
+    // without reading the clock if not profiling.
+    std::int64_t lap(std::chrono::steady_clock::time_point &mark) const;
+
+    // Size of the off-screen "kuiper zone" beyond each edge.
+    PairXy kuiperMargin() const;
 
     // Generate random velocity.
     PairXy randomXy(double max) const
@@ -179,6 +375,12 @@ private:
     {
         return kind != EntityKind::Ship && kind != EntityKind::Bullet;
     }
+
+    // Returns true if kind x reacts to kind y at any distance.
+    static inline bool sees(EntityKind x, EntityKind y)
+    {
+        return (sightMask(x) & kindBit(y)) != 0;
+    }
 };
 
 }} // namespace
@@ -0,0 +1,95 @@
+//---------------------------------------------------------------------------
+// PROJECT      : Asteroid Style Game
+// COPYRIGHT    : Andy Thomas (C) 2019
+// WEB URL      : https://kuiper.zone
+// LICENSE      : GPLv3
+//---------------------------------------------------------------------------
+
+#include "null_canvas.h"
+
+using namespace Game;
+
+//---------------------------------------------------------------------------
+// CLASS NullCanvas : PUBLIC MEMBERS
+//---------------------------------------------------------------------------
+NullCanvas::NullCanvas(double width, double height)
+    : _width {width}, _height {height}
+{
+}
+
+void NullCanvas::setSize(double width, double height)
+{
+    _width = width;
+    _height = height;
+}
+
+std::int64_t NullCanvas::lineCount() const
+{
+    return _lineCount;
+}
+
+std::int64_t NullCanvas::textCount() const
+{
+    return _textCount;
+}
+
+std::int64_t NullCanvas::soundCount() const
+{
+    return _soundCount;
+}
+
+double NullCanvas::width() const
+{
+    return _width;
+}
+
+double NullCanvas::height() const
+{
+    return _height;
+}
+
+void NullCanvas::beginDraw()
+{
+}
+
+void NullCanvas::endDraw()
+{
+}
+
+void NullCanvas::drawLine(const PairXy &, const PairXy &)
+{
+    _lineCount += 1;
+}
+
+void NullCanvas::drawPolyline(const PairXy *points, std::size_t count)
+{
+    for(std::size_t n = 1; n < count; ++n)
+    {
+        if (!points[n - 1].isNaN() && !points[n].isNaN())
+        {
+            _lineCount += 1;
+        }
+    }
+}
+
+double NullCanvas::drawText(const PairXy &, AlignHorz, AlignVert,
+    double rem, const std::string &text)
+{
+    _textCount += 1;
+    return textHeight(rem, text);
+}
+
+double NullCanvas::textHeight(double rem, const std::string &) const
+{
+    // Nominal line height
+    return rem * 16;
+}
+
+void NullCanvas::playSound(SoundId, SoundOpt)
+{
+    _soundCount += 1;
+}
+
+void NullCanvas::stopSound(SoundId)
+{
+}
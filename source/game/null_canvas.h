@@ -0,0 +1,64 @@
+//---------------------------------------------------------------------------
+// PROJECT      : Asteroid Style Game
+// COPYRIGHT    : Andy Thomas (C) 2019
+// WEB URL      : https://kuiper.zone
+// LICENSE      : GPLv3
+//---------------------------------------------------------------------------
+
+#ifndef GAME_NULL_CANVAS_H
+#define GAME_NULL_CANVAS_H
+
+#include "canvas_interface.h"
+
+#include <cstdint>
+
+namespace Game {
+
+//! A concrete implementation of CanvasInterface which draws nothing and plays
+//! no sound. It has fixed dimensions, given on construction, and counts the
+//! calls made to it. It allows the game to be run headless, i.e. where there
+//! is no display, such as for testing and performance measurement.
+class NullCanvas : public CanvasInterface
+{
+public:
+
+    //! Constructor with canvas dimensions.
+    NullCanvas(double width = 1280, double height = 720);
+
+    //! Sets the canvas dimensions.
+    void setSize(double width, double height);
+
+    //! The number of lines drawn since construction, whether by drawLine()
+    //! or drawPolyline().
+    std::int64_t lineCount() const;
+
+    //! The number of calls to drawText() since construction.
+    std::int64_t textCount() const;
+
+    //! The number of calls to playSound() since construction.
+    std::int64_t soundCount() const;
+
+    // Implements CanvasInterface.
+    double width() const override;
+    double height() const override;
+    void beginDraw() override;
+    void endDraw() override;
+    void drawLine(const PairXy &p1, const PairXy &p2) override;
+    void drawPolyline(const PairXy *points, std::size_t count) override;
+    double drawText(const PairXy &pos, AlignHorz horz, AlignVert vert,
+        double rem, const std::string &text) override;
+    double textHeight(double rem, const std::string &text) const override;
+    void playSound(SoundId id, SoundOpt opt) override;
+    void stopSound(SoundId id) override;
+
+private:
+
+    double _width;
+    double _height;
+    std::int64_t _lineCount {0};
+    std::int64_t _textCount {0};
+    std::int64_t _soundCount {0};
+};
+
+} // namespace
+#endif
@@ -0,0 +1,97 @@
+//---------------------------------------------------------------------------
+// PROJECT      : Asteroid Style Game
+// COPYRIGHT    : Andy Thomas (C) 2019
+// WEB URL      : https://kuiper.zone
+// LICENSE      : GPLv3
+//---------------------------------------------------------------------------
+
+#ifndef GAME_PAIR_SPAN_H
+#define GAME_PAIR_SPAN_H
+
+#include "pair_xy.h"
+
+#include <cstddef>
+
+namespace Game {
+
+//! Batch operations on contiguous arrays of BasicPairXy values, such as
+//! polygon points. In each, src and dest hold count elements. They may be
+//! the same array, but otherwise should not overlap. Each function gives the
+//! same result as applying the equivalent PairXy operation per point, but
+//! runs as a simple loop which the compiler is able to unroll and vectorise.
+
+//! Adds offset to each point. NaN points remain NaN.
+template <typename T>
+void translate(const BasicPairXy<T> *src, BasicPairXy<T> *dest, std::size_t count,
+    const BasicPairXy<T> &offset)
+{
+    for(std::size_t n = 0; n < count; ++n)
+    {
+        // NaN would propagate for float and double, but not Fixed
+        dest[n] = src[n].isNaN() ? src[n] : src[n] + offset;
+    }
+}
+
+//! Rotates each point around the origin by angle alpha (radians). The sine
+//! and cosine are calculated once only. NaN points remain NaN.
+template <typename T>
+void rotate(const BasicPairXy<T> *src, BasicPairXy<T> *dest, std::size_t count, double alpha)
+{
+    if (alpha == 0)
+    {
+        if (src != dest)
+        {
+            for(std::size_t n = 0; n < count; ++n)
+            {
+                dest[n] = src[n];
+            }
+        }
+
+        return;
+    }
+
+    T cs = cosine<T>(alpha);
+    T sn = sine<T>(alpha);
+
+    for(std::size_t n = 0; n < count; ++n)
+    {
+        dest[n] = src[n].isNaN() ? src[n] : src[n].rotate(cs, sn);
+    }
+}
+
+//! Multiplies each point by factor.
+template <typename T>
+void scale(const BasicPairXy<T> *src, BasicPairXy<T> *dest, std::size_t count,
+    typename BasicPairXy<T>::Scalar factor)
+{
+    for(std::size_t n = 0; n < count; ++n)
+    {
+        dest[n] = src[n] * factor;
+    }
+}
+
+//! Limits each component to no greater than max in magnitude.
+//! See PairXy::throttle().
+template <typename T>
+void throttle(const BasicPairXy<T> *src, BasicPairXy<T> *dest, std::size_t count,
+    typename BasicPairXy<T>::Scalar max)
+{
+    for(std::size_t n = 0; n < count; ++n)
+    {
+        dest[n] = src[n].throttle(max);
+    }
+}
+
+//! Writes the squared distance of each point from origin to dest.
+template <typename T>
+void distanceSquared(const BasicPairXy<T> *src, T *dest, std::size_t count,
+    const BasicPairXy<T> &origin)
+{
+    for(std::size_t n = 0; n < count; ++n)
+    {
+        dest[n] = (src[n] - origin).absSquared();
+    }
+}
+
+} // namespace
+#endif
@@ -8,50 +8,107 @@
 #ifndef GAME_PAIR_XY_H
 #define GAME_PAIR_XY_H
 
+#include "real.h"
+
+#include <cmath>
+#include <limits>
+
 namespace Game {
 
 //! An x-y value pair which can be used to specify both position and
-//! velocity. A basic set of operators are also provided.
-class PairXy
+//! velocity. A basic set of operators are also provided. The class is
+//! header only so that all operations may be inlined, and those which
+//! do not call into the math library are constexpr. The component type
+//! T is float, double or Fixed. The game uses PairXy, for which T is Real.
+template <typename T>
+class BasicPairXy
 {
 public:
 
+    //! Component type.
+    typedef T Scalar;
+
     //! Default constructor. Both x and y are assigned 0.
-    PairXy() = default;
+    constexpr BasicPairXy() = default;
 
      //! Copy constructor.
-    PairXy(const PairXy &other) = default;
+    constexpr BasicPairXy(const BasicPairXy &other) = default;
 
     //! Assignment constructor.
-    PairXy(double x, double y);
+    constexpr BasicPairXy(T x, T y)
+        : _x{x}, _y{y}
+    {
+    }
 
     //! Explicity constructor. If nan is true, both x and y are
     //! assigned the value NAN. If nan is false, both are assigned 0.
-    explicit PairXy(bool nan);
+    constexpr explicit BasicPairXy(bool nan)
+        : _x{nan ? std::numeric_limits<T>::quiet_NaN() : T(0)},
+          _y{nan ? std::numeric_limits<T>::quiet_NaN() : T(0)}
+    {
+    }
+
+    //! Assignment operator.
+    BasicPairXy& operator= (const BasicPairXy &other) = default;
 
     //! Gets and sets x coordinate.
-    double x() const { return _x; }
-    void setX(double x) { _x = x; }
+    constexpr T x() const { return _x; }
+    void setX(T x) { _x = x; }
 
     //! Gets and sets y coordinate.
-    double y() const { return _y; }
-    void setY(double y) { _y = y; }
+    constexpr T y() const { return _y; }
+    void setY(T y) { _y = y; }
 
     //! Returns true if either x or y are NAN.
-    bool isNaN() const;
+    constexpr bool isNaN() const
+    {
+        // NaN is the only value not equal to itself
+        return _x != _x || _y != _y;
+    }
 
     //! Returns the absolute magntitude.
-    double abs() const;
+    T abs() const
+    {
+        // Argument dependent lookup finds sqrt(Fixed)
+        using std::sqrt;
+        return sqrt(_x * _x + _y * _y);
+    }
+
+    //! Returns the square of the absolute magnitude. Use
+    //! in comparisons to avoid the square root of abs().
+    constexpr T absSquared() const
+    {
+        return _x * _x + _y * _y;
+    }
 
     //! Returns a copy in which each component is no greater in
     //! magnitude than max. Max should be a positive value.
-    const PairXy throttle(double max) const;
+    constexpr const BasicPairXy throttle(T max) const
+    {
+        return isNaN() ? *this : BasicPairXy(clamp(_x, max), clamp(_y, max));
+    }
 
     //! Rotates the point around the origin by angle alpha (radians).
-    const PairXy rotate(double alpha) const;
+    const BasicPairXy rotate(double alpha) const
+    {
+        if (alpha == 0 || isNaN())
+        {
+            return *this;
+        }
+
+        return rotate(cosine<T>(alpha), sine<T>(alpha));
+    }
+
+    //! Rotates the point around the origin, where cs and sn are the
+    //! cosine and sine of the angle. Allows these to be calculated once
+    //! when rotating many points by the same angle.
+    constexpr const BasicPairXy rotate(T cs, T sn) const
+    {
+        return BasicPairXy(cs * _x - sn * _y, sn * _x + cs * _y);
+    }
 
     //! Addition operator.
-    PairXy& operator+= (const PairXy &other)
+    BasicPairXy& operator+= (const BasicPairXy &other)
     {
         _x += other._x;
         _y += other._y;
@@ -59,7 +116,7 @@ public:
     }
 
     //! Subtraction operator.
-    PairXy& operator-= (const PairXy &other)
+    BasicPairXy& operator-= (const BasicPairXy &other)
     {
         _x -= other._x;
         _y -= other._y;
@@ -67,7 +124,7 @@ public:
     }
 
     //! Multiplication operator.
-    PairXy& operator*= (double value)
+    BasicPairXy& operator*= (T value)
     {
         _x *= value;
         _y *= value;
@@ -75,7 +132,7 @@ public:
     }
 
     //! Division operator.
-    PairXy& operator/= (double value)
+    BasicPairXy& operator/= (T value)
     {
         _x /= value;
         _y /= value;
@@ -83,35 +140,57 @@ public:
     }
 
     //! Equality operator.
-    bool operator== (const PairXy &other) const
+    constexpr bool operator== (const BasicPairXy &other) const
     {
         return _x == other._x && _y == other._y;
     }
 
     //! Inequality operator.
-    bool operator!= (const PairXy &other) const
+    constexpr bool operator!= (const BasicPairXy &other) const
     {
         return _x != other._x || _y != other._y;
     }
 
-private:
+    //! Non-member addition operator.
+    friend constexpr const BasicPairXy operator+(const BasicPairXy &p1, const BasicPairXy &p2)
+    {
+        return BasicPairXy(p1._x + p2._x, p1._y + p2._y);
+    }
 
-    double _x {0};
-    double _y {0};
+    //! Non-member subration operator.
+    friend constexpr const BasicPairXy operator-(const BasicPairXy &p1, const BasicPairXy &p2)
+    {
+        return BasicPairXy(p1._x - p2._x, p1._y - p2._y);
+    }
 
-};
+    //! Non-member multiplication operator. Defined in the class, so that
+    //! the value may be given as any type convertible to T.
+    friend constexpr const BasicPairXy operator*(const BasicPairXy &p1, T value)
+    {
+        return BasicPairXy(p1._x * value, p1._y * value);
+    }
 
-//! Non-member addition operator.
-const PairXy operator+(const PairXy &p1, const PairXy &p2);
+    //! Non-member division operator.
+    friend constexpr const BasicPairXy operator/(const BasicPairXy &p1, T value)
+    {
+        return BasicPairXy(p1._x / value, p1._y / value);
+    }
 
-//! Non-member subration operator.
-const PairXy operator-(const PairXy &p1, const PairXy &p2);
+private:
 
-//! Non-member multiplication operator.
-const PairXy operator*(const PairXy &p1, double value);
+    // Lower bound takes precedence, should max be negative
+    static constexpr T clamp(T v, T max)
+    {
+        return v < -max ? -max : (v > max ? max : v);
+    }
+
+    T _x {0};
+    T _y {0};
+
+};
 
-//! Non-member division operator.
-const PairXy operator/(const PairXy &p1, double value);
+//! The x-y pair used throughout the game.
+typedef BasicPairXy<Real> PairXy;
 
 } // namespace
 #endif
@@ -6,15 +6,18 @@
 //---------------------------------------------------------------------------
 
 #include "player.h"
+#include "input_log.h"
 #include "internal/universe.h"
 #include "internal/scaled_canvas.h"
 #include "internal/ship.h"
 #include "internal/ufo.h"
 #include "internal/label.h"
+#include "internal/simd.h"
 
 #include <cmath>
 #include <cstdlib>
 #include <algorithm>
+#include <ctime>
 
 using namespace Game;
 using namespace Game::Internal;
@@ -27,16 +30,24 @@ using namespace Game::Internal;
 // of it is needed by the calling application.
 const int Player::PollInterval = Universe::PollInterval;
 
+const int Player::KindCount = static_cast<int>(EntityKind::Label) + 1;
+
 Player::Player(CanvasInterface *widget)
+    : Player(widget, static_cast<std::uint64_t>(std::time(0)))
+{
+}
+
+Player::Player(CanvasInterface *widget, std::uint64_t seed)
+    : _seed {seed}, _widget {widget}
 {
     // Universe will delete ScaledCanvas, but
     // ScaledCanvas won't delete widget.
-    _universe = new Internal::Universe(new Internal::ScaledCanvas(widget));
+    _universe = new Internal::Universe(new Internal::ScaledCanvas(widget), seed);
     _universe->canvas()->setSoundOn(true);
 
     // Keep a separate universe for the demo.
     // We should be OK sharing the same widget.
-    _demo = new Internal::Universe(new Internal::ScaledCanvas(widget));
+    _demo = new Internal::Universe(new Internal::ScaledCanvas(widget), Random::hash(seed));
     _demo->canvas()->setSoundOn(false);
 
     // Initialise state
@@ -62,18 +73,28 @@ void Player::setSoundOn(bool on)
     _universe->canvas()->setSoundOn(on);
 }
 
-void Player::startGame()
+std::uint64_t Player::seed() const
 {
-    _page = PageId::Game;
-    _universe->start();
+    return _seed;
+}
 
-    Label* lab = new Label(_universe, "NEW GAME", 2);
-    lab->setRem(2);
-    _universe->add(lab, Universe::Position::Upper);
+std::int64_t Player::ticks() const
+{
+    return _clock;
+}
 
-    // Ensure reset
-    _paused = false;
-    _ufoFlag = false;
+void Player::startGame()
+{
+    if (_replayLog == nullptr)
+    {
+        if (_recordLog != nullptr)
+        {
+            syncSize();
+            _recordLog->append({_clock, InputLog::Action::Start, KeyId::Count, 0, 0});
+        }
+
+        doStartGame();
+    }
 }
 
 bool Player::inPlay() const
@@ -83,6 +104,46 @@ bool Player::inPlay() const
 
 void Player::advance()
 {
+    if (_replayLog != nullptr)
+    {
+        // Apply events of this tick
+        while(_replayIndex < _replayLog->size() && _replayLog->at(_replayIndex).tick <= _clock)
+        {
+            const InputLog::Event &e = _replayLog->at(_replayIndex++);
+
+            switch(e.action)
+            {
+            case InputLog::Action::KeyUp:
+            case InputLog::Action::KeyDown:
+                doInkey(e.key, e.action == InputLog::Action::KeyDown);
+                break;
+            case InputLog::Action::Start:
+                doStartGame();
+                break;
+            case InputLog::Action::Resize:
+                setDeviceSize(e.width, e.height);
+                break;
+            }
+        }
+
+        if (_replayIndex == _replayLog->size())
+        {
+            _replayLog = nullptr;
+        }
+    }
+    else
+    if (_recordLog != nullptr)
+    {
+        syncSize();
+    }
+
+    _clock += 1;
+
+    if (_autopilot)
+    {
+        driveGame();
+    }
+
     if (_page != PageId::Game)
     {
         _ticker += 1;
@@ -115,7 +176,7 @@ void Player::advance()
             _universe->advance();
         }
 
-        if (_universe->gameOver())
+        if (_universe->gameOver() && !_autopilot)
         {
             // Game finished
             _ticker = 0;
@@ -150,6 +211,171 @@ void Player::draw()
 }
 
 bool Player::inkey(KeyId key, bool down)
+{
+    if (_replayLog != nullptr)
+    {
+        return false;
+    }
+
+    if (_recordLog != nullptr && key != KeyId::Count)
+    {
+        syncSize();
+        _recordLog->append({_clock, down ? InputLog::Action::KeyDown : InputLog::Action::KeyUp, key, 0, 0});
+    }
+
+    return doInkey(key, down);
+}
+
+bool Player::record(InputLog *log)
+{
+    if ((log != nullptr && _clock != 0) || _replayLog != nullptr)
+    {
+        return false;
+    }
+
+    _recordLog = log;
+
+    if (log != nullptr)
+    {
+        log->clear();
+        log->setSeed(_seed);
+        syncSize();
+    }
+
+    return true;
+}
+
+bool Player::replay(const InputLog *log)
+{
+    if (_clock != 0 || _recordLog != nullptr || log == nullptr || log->seed() != _seed)
+    {
+        return false;
+    }
+
+    _replayLog = log;
+    _replayIndex = 0;
+    return true;
+}
+
+bool Player::replaying() const
+{
+    return _replayLog != nullptr;
+}
+
+bool Player::autopilot() const
+{
+    return _autopilot;
+}
+
+void Player::setAutopilot(bool on)
+{
+    _autopilot = on;
+}
+
+int Player::threadCount() const
+{
+    return _universe->threadCount();
+}
+
+void Player::setThreadCount(int count)
+{
+    _universe->setThreadCount(count);
+}
+
+Player::Stats Player::stats() const
+{
+    Stats s;
+    s.entities = static_cast<std::int64_t>(_universe->store().size() - _universe->store().holes());
+    s.drawn = _universe->drawStats().drawn;
+    s.culled = _universe->drawStats().culled;
+    s.score = _universe->score();
+    return s;
+}
+
+void Player::entities(std::vector<EntityState> &dest) const
+{
+    const EntityStore &store = _universe->store();
+    dest.clear();
+
+    for(std::size_t n = 0; n < store.size(); ++n)
+    {
+        GameEntity *e = store.entity(n);
+
+        if (e != nullptr)
+        {
+            dest.push_back({e->serial(), static_cast<int>(store.kind(n)), store.position(n)});
+        }
+    }
+}
+
+std::string Player::kindName(int kind)
+{
+    switch(static_cast<EntityKind>(kind))
+    {
+    case EntityKind::Ship: return "Ship";
+    case EntityKind::BigRock: return "BigRock";
+    case EntityKind::MediumRock: return "MediumRock";
+    case EntityKind::SmallRock: return "SmallRock";
+    case EntityKind::Bullet: return "Bullet";
+    case EntityKind::Debris: return "Debris";
+    case EntityKind::Spark: return "Spark";
+    case EntityKind::Ufo: return "Ufo";
+    case EntityKind::Label: return "Label";
+    default: return "";
+    }
+}
+
+bool Player::setSimdLevel(const std::string &name)
+{
+    SimdLevel level;
+
+    if (simdParse(name, level))
+    {
+        setSimdDefault(level);
+        return true;
+    }
+
+    return false;
+}
+
+std::string Player::simdLevel()
+{
+    return simdName(simdDefault());
+}
+
+std::string Player::keyName(KeyId key) const
+{
+    switch(key)
+    {
+    case KeyId::Left: return "LEFT or J";
+    case KeyId::Right: return "RIGHT or L";
+    case KeyId::Thrust: return "UP or I";
+    case KeyId::Fire: return "SPACE or CTRL";
+    case KeyId::Quit: return "ESC";
+    case KeyId::Pause: return "P";
+    case KeyId::Sound: return "S";
+    default: return "";
+    }
+}
+
+//---------------------------------------------------------------------------
+// CLASS Player : PRIVATE MEMBERS
+//---------------------------------------------------------------------------
+void Player::doStartGame()
+{
+    _page = PageId::Game;
+    _universe->start();
+
+    Label* lab = new (_universe) Label(_universe, "NEW GAME", 2);
+    lab->setRem(2);
+    _universe->add(lab, Universe::Position::Upper);
+
+    // Ensure reset
+    _paused = false;
+    _ufoFlag = false;
+}
+
+bool Player::doInkey(KeyId key, bool down)
 {
     if (key == KeyId::Sound)
     {
@@ -170,7 +396,7 @@ bool Player::inkey(KeyId key, bool down)
             if (_paused)
             {
                 // An easy way to add a pause indicator
-                Label *lab = new Label(_universe, "PAUSED", 0.1);
+                Label *lab = new (_universe) Label(_universe, "PAUSED", 0.1);
                 lab->setRem(2);
                 _universe->add(lab, Universe::Position::Upper);
             }
@@ -222,7 +448,7 @@ bool Player::inkey(KeyId key, bool down)
     {
         if (down)
         {
-            startGame();
+            doStartGame();
         }
 
         return true;
@@ -231,24 +457,26 @@ bool Player::inkey(KeyId key, bool down)
     return false;
 }
 
-std::string Player::keyName(KeyId key) const
+void Player::syncSize()
 {
-    switch(key)
+    double w = _widget->width();
+    double h = _widget->height();
+
+    if (w != _deviceWidth || h != _deviceHeight)
     {
-    case KeyId::Left: return "LEFT or J";
-    case KeyId::Right: return "RIGHT or L";
-    case KeyId::Thrust: return "UP or I";
-    case KeyId::Fire: return "SPACE or CTRL";
-    case KeyId::Quit: return "ESC";
-    case KeyId::Pause: return "P";
-    case KeyId::Sound: return "S";
-    default: return "";
+        _recordLog->append({_clock, InputLog::Action::Resize, KeyId::Count, w, h});
+        setDeviceSize(w, h);
     }
 }
 
-//---------------------------------------------------------------------------
-// CLASS Player : PRIVATE MEMBERS
-//---------------------------------------------------------------------------
+void Player::setDeviceSize(double width, double height)
+{
+    _deviceWidth = width;
+    _deviceHeight = height;
+    _universe->canvas()->setDeviceSize(width, height);
+    _demo->canvas()->setDeviceSize(width, height);
+}
+
 void Player::drawIntro(PageId page)
 {
     // Draw onto canvas supplied to the universe
@@ -307,16 +535,35 @@ void Player::driveDemo()
         // Restart
         _demo->start(1);
 
-        Label* lab = new Label(_demo, "INSERT COIN", -1);
+        Label* lab = new (_demo) Label(_demo, "INSERT COIN", -1);
         lab->setRem(2);
         _demo->add(lab, Universe::Position::Upper);
     }
 
-    Ship *ship = _demo->ship();
+    pilot(_demo);
+    _demo->advance();
+}
+
+void Player::driveGame()
+{
+    // Straight into play, without intro
+    _page = PageId::Game;
+
+    if (_universe->gameOver())
+    {
+        _universe->start(1);
+    }
+
+    pilot(_universe);
+}
+
+void Player::pilot(Internal::Universe *universe)
+{
+    Ship *ship = universe->ship();
 
     if (ship != nullptr)
     {
-        double r = _demo->random();
+        double r = universe->random();
 
         if (r < 0.1)
         {
@@ -352,6 +599,4 @@ void Player::driveDemo()
             ship->thrust(false);
         }
     }
-
-    _demo->advance();
 }
@@ -14,6 +14,7 @@
 
 #include <vector>
 #include <string>
+#include <cstdint>
 
 namespace Game {
 
@@ -30,6 +31,8 @@ const std::string LicenseName = "GPLv3";
 const std::string WebUrl = "https://kuiper.zone";
 
 // Forwards
+class InputLog;
+
 namespace Internal {
 class Universe;
 }
@@ -50,14 +53,58 @@ public:
     //! The advance() poll interval in milliseconds.
     static const int PollInterval;
 
+    //! The number of entity kinds. See kindName().
+    static const int KindCount;
+
+    //! Counters of the game, rather than the demo, for diagnostic use.
+    struct Stats
+    {
+        //! Number of entities in play.
+        std::int64_t entities {0};
+
+        //! Number of entities drawn by the last draw() of the game.
+        std::int64_t drawn {0};
+
+        //! Number of entities not drawn by the last draw() of the game, as
+        //! wholly beyond the visible region.
+        std::int64_t culled {0};
+
+        //! The score of the current or last game.
+        int score {0};
+    };
+
+    //! State of an entity in play, for diagnostic use.
+    struct EntityState
+    {
+        //! Serial number, which identifies the entity. It is the same in any
+        //! run given the same seed and input.
+        std::uint64_t serial;
+
+        //! The kind of entity, less than KindCount. See kindName().
+        int kind;
+
+        //! Position in game units.
+        PairXy position;
+    };
+
     //! Constructor. The caller must supply a concrete instance of CanvasInterface
     //! which must remain valid for the lifetime of this instance. Universe will
-    //! not delete it on destruction.
+    //! not delete it on destruction. The random seed is taken from the time.
     Player(CanvasInterface *widget);
 
+    //! Constructor with an explicit random seed. Instances constructed with
+    //! the same seed, and given the same input, play an identical game.
+    Player(CanvasInterface *widget, std::uint64_t seed);
+
     //! Destructor.
     virtual ~Player();
 
+    //! The seed supplied on construction.
+    std::uint64_t seed() const;
+
+    //! The number of calls made to advance().
+    std::int64_t ticks() const;
+
     //! Called to start a new game. If a game is in play, it is reset.
     void startGame();
 
@@ -84,6 +131,61 @@ public:
     //! result is true if key is not KeyId::Count.
     bool inkey(KeyId key, bool down);
 
+    //! Records subsequent calls to inkey() and startGame(), together with changes
+    //! in canvas dimensions, to log. The log is cleared and given the seed of this
+    //! instance. The log must remain valid while recording, which continues until
+    //! record(nullptr) is called. The result is false if advance() has already
+    //! been called, or if replaying.
+    bool record(InputLog *log);
+
+    //! Replays the input held by log. On each call to advance(), the events of
+    //! that tick are applied before the game is advanced, so the recorded game is
+    //! reproduced exactly. The inkey() and startGame() methods are ignored while
+    //! replaying. Canvas dimensions are taken from the log, although drawing is
+    //! scaled to the actual canvas. As advance() does not depend on draw(), a
+    //! replay may be run at any speed without drawing. The log must remain valid
+    //! until replaying() is false. The result is false if advance() has already
+    //! been called, or if the seed of log differs from that of this instance.
+    bool replay(const InputLog *log);
+
+    //! Returns true until all events given to replay() have been applied.
+    bool replaying() const;
+
+    //! Sets whether the game is played by the autopilot which plays the demo,
+    //! rather than by input. While on, advance() skips the intro pages and
+    //! starts a game of one life whenever the last is over. Intended for
+    //! benchmarking. The initial value is false.
+    bool autopilot() const;
+    void setAutopilot(bool on);
+
+    //! The number of threads used to detect collisions in the game. The outcome
+    //! of the game is identical for any value. The initial value is 1.
+    int threadCount() const;
+    void setThreadCount(int count);
+
+    //! Gets the counters of the game.
+    Stats stats() const;
+
+    //! Replaces the content of dest with the state of the entities in play in
+    //! the game, rather than the demo, in order of creation.
+    void entities(std::vector<EntityState> &dest) const;
+
+    //! Gets the name of the entity kind given by an index less than KindCount,
+    //! i.e. "Ship", "BigRock", "MediumRock", "SmallRock", "Bullet", "Debris",
+    //! "Spark", "Ufo" or "Label". The result is empty for other values.
+    static std::string kindName(int kind);
+
+    //! Sets the level of SIMD kernels with which instances subsequently
+    //! constructed play, given by name, i.e. "scalar", "sse2", "sse4.2", "avx2"
+    //! or "avx512", ignoring case. A level greater than supported is reduced to
+    //! the greatest supported. The result is false if name is not recognised.
+    //! Intended for benchmarking. Not thread safe.
+    static bool setSimdLevel(const std::string &name);
+
+    //! Gets the name of the level of SIMD kernels with which instances
+    //! subsequently constructed play. See setSimdLevel().
+    static std::string simdLevel();
+
     //! Gets a short descriptive name for the given action key. This is used
     //! in the introductory screens to display game keys. It may potentially
     //! by overridden to display different values.
@@ -100,18 +202,34 @@ private:
     enum class PageId {Intro0 = 0, Intro1, Intro2, Demo, Game};
 
     int _ticker {0};
+    std::int64_t _clock {0};
+    std::uint64_t _seed;
     bool _introPlayed {false};
     bool _keyDown[KeyCount];
     bool _ufoFlag {false};
     bool _paused {false};
+    bool _autopilot {false};
     KeyId _simkey {KeyId::Count};
 
     PageId _page {PageId::Intro0};
+    CanvasInterface *_widget;
     Internal::Universe *_universe;
     Internal::Universe *_demo;
 
+    InputLog *_recordLog {nullptr};
+    const InputLog *_replayLog {nullptr};
+    std::size_t _replayIndex {0};
+    double _deviceWidth {-1};
+    double _deviceHeight {-1};
+
+    void doStartGame();
+    bool doInkey(KeyId key, bool down);
+    void syncSize();
+    void setDeviceSize(double width, double height);
     void drawIntro(PageId page);
     void driveDemo();
+    void driveGame();
+    static void pilot(Internal::Universe *universe);
 };
 
 } // namespace
@@ -0,0 +1,76 @@
+//---------------------------------------------------------------------------
+// PROJECT      : Asteroid Style Game
+// COPYRIGHT    : Andy Thomas (C) 2019
+// WEB URL      : https://kuiper.zone
+// LICENSE      : GPLv3
+//---------------------------------------------------------------------------
+
+#ifndef GAME_REAL_H
+#define GAME_REAL_H
+
+#include "fixed.h"
+
+#include <cmath>
+#include <type_traits>
+
+namespace Game {
+
+//! The scalar type of entity state, i.e. positions, velocities, radii, masses
+//! and polygon points. It is double by default, and may be one of:
+//!
+//! float - where GAME_REAL_FLOAT is defined (qmake CONFIG+=float_physics).
+//! This halves the size of entity state, and is ample for the scaled
+//! playfield of 800x600. However, as rounding differs, the game played from
+//! a given seed will diverge from that of the double build after a while.
+//! The headless runner can measure this with its --trace and --drift options.
+//!
+//! Fixed - where GAME_REAL_FIXED is defined (qmake CONFIG+=fixed_physics).
+//! Physics is on integers, and trigonometry is by table lookup rather than
+//! the math library, so that a game, and therefore a replay, is identical on
+//! any machine. Like float, it plays a different game to the double build.
+//!
+//! The setting must be the same for all code which includes game headers.
+#if defined(GAME_REAL_FIXED)
+typedef Fixed Real;
+#elif defined(GAME_REAL_FLOAT)
+typedef float Real;
+#else
+typedef double Real;
+#endif
+
+//! Returns "double", "float" or "fixed" according to Real.
+inline const char* realName()
+{
+    return std::is_same<Real, Fixed>::value ? "fixed"
+        : (std::is_same<Real, float>::value ? "float" : "double");
+}
+
+//! Sine and cosine of alpha (radians) as type T. Where T is Fixed, values are
+//! by table lookup. See Fixed::sin(). Game logic should use these, rather
+//! than std::sin() or std::cos(), so that the fixed point build is exact.
+template <typename T>
+inline T sine(double alpha)
+{
+    return static_cast<T>(std::sin(alpha));
+}
+
+template <typename T>
+inline T cosine(double alpha)
+{
+    return static_cast<T>(std::cos(alpha));
+}
+
+template <>
+inline Fixed sine<Fixed>(double alpha)
+{
+    return Fixed::sin(alpha);
+}
+
+template <>
+inline Fixed cosine<Fixed>(double alpha)
+{
+    return Fixed::cos(alpha);
+}
+
+} // namespace
+#endif
@@ -0,0 +1,188 @@
+//---------------------------------------------------------------------------
+// PROJECT      : Asteroid Style Game
+// COPYRIGHT    : Andy Thomas (C) 2019
+// WEB URL      : https://kuiper.zone
+// LICENSE      : GPLv3
+//---------------------------------------------------------------------------
+
+#include "recording_canvas.h"
+
+using namespace Game;
+
+//---------------------------------------------------------------------------
+// CLASS RecordingCanvas : PUBLIC MEMBERS
+//---------------------------------------------------------------------------
+RecordingCanvas::RecordingCanvas(double width, double height)
+    : _width {width}, _height {height}
+{
+}
+
+RecordingCanvas::RecordingCanvas(const CanvasInterface *metrics)
+    : _metrics {metrics}
+{
+}
+
+void RecordingCanvas::setSize(double width, double height)
+{
+    _width = width;
+    _height = height;
+}
+
+void RecordingCanvas::clear()
+{
+    _commands.clear();
+    _points.clear();
+    _text.clear();
+}
+
+bool RecordingCanvas::empty() const
+{
+    return _commands.empty();
+}
+
+std::size_t RecordingCanvas::commandCount() const
+{
+    return _commands.size();
+}
+
+std::size_t RecordingCanvas::pointCount() const
+{
+    return _points.size();
+}
+
+void RecordingCanvas::replay(CanvasInterface *dest) const
+{
+    std::size_t point = 0;
+    std::size_t text = 0;
+
+    for(std::size_t n = 0; n < _commands.size(); ++n)
+    {
+        const Command &c = _commands[n];
+
+        switch(c.op)
+        {
+        case Op::Begin:
+            dest->beginDraw();
+            break;
+        case Op::End:
+            dest->endDraw();
+            break;
+        case Op::Lines:
+            dest->drawPolyline(_points.data() + point, c.count);
+            point += c.count;
+            break;
+        case Op::Text:
+            dest->drawText(_points[point], static_cast<AlignHorz>(c.arg1),
+                static_cast<AlignVert>(c.arg2), c.rem, _text.substr(text, c.count));
+            point += 1;
+            text += c.count;
+            break;
+        case Op::Play:
+            dest->playSound(static_cast<SoundId>(c.arg1), static_cast<SoundOpt>(c.arg2));
+            break;
+        case Op::Stop:
+            dest->stopSound(static_cast<SoundId>(c.arg1));
+            break;
+        }
+    }
+}
+
+double RecordingCanvas::width() const
+{
+    return _metrics != nullptr ? _metrics->width() : _width;
+}
+
+double RecordingCanvas::height() const
+{
+    return _metrics != nullptr ? _metrics->height() : _height;
+}
+
+void RecordingCanvas::beginDraw()
+{
+    add(Op::Begin);
+}
+
+void RecordingCanvas::endDraw()
+{
+    add(Op::End);
+}
+
+void RecordingCanvas::drawLine(const PairXy &p1, const PairXy &p2)
+{
+    const PairXy points[] = {p1, p2};
+    drawPolyline(points, 2);
+}
+
+void RecordingCanvas::drawPolyline(const PairXy *points, std::size_t count)
+{
+    if (count > 1)
+    {
+        std::size_t first = 0;
+
+        if (_commands.empty() || _commands.back().op != Op::Lines)
+        {
+            add(Op::Lines);
+        }
+        else if (_points.back() == points[0])
+        {
+            // Continues the last line
+            first = 1;
+        }
+        else
+        {
+            _points.push_back(PairXy(true));
+            _commands.back().count += 1;
+        }
+
+        _points.insert(_points.end(), points + first, points + count);
+        _commands.back().count += static_cast<std::uint32_t>(count - first);
+    }
+}
+
+double RecordingCanvas::drawText(const PairXy &pos, AlignHorz horz, AlignVert vert,
+    double rem, const std::string &text)
+{
+    add(Op::Text, static_cast<std::uint8_t>(horz), static_cast<std::uint8_t>(vert),
+        static_cast<std::uint32_t>(text.size()), rem);
+
+    _points.push_back(pos);
+    _text += text;
+
+    return textHeight(rem, text);
+}
+
+double RecordingCanvas::textHeight(double rem, const std::string &text) const
+{
+    if (_metrics != nullptr)
+    {
+        return _metrics->textHeight(rem, text);
+    }
+
+    // Nominal line height
+    return rem * 16;
+}
+
+void RecordingCanvas::playSound(SoundId id, SoundOpt opt)
+{
+    add(Op::Play, static_cast<std::uint8_t>(id), static_cast<std::uint8_t>(opt));
+}
+
+void RecordingCanvas::stopSound(SoundId id)
+{
+    add(Op::Stop, static_cast<std::uint8_t>(id));
+}
+
+//---------------------------------------------------------------------------
+// CLASS RecordingCanvas : PRIVATE MEMBERS
+//---------------------------------------------------------------------------
+void RecordingCanvas::add(Op op, std::uint8_t arg1, std::uint8_t arg2,
+    std::uint32_t count, double rem)
+{
+    Command c;
+    c.op = op;
+    c.arg1 = arg1;
+    c.arg2 = arg2;
+    c.count = count;
+    c.rem = rem;
+    _commands.push_back(c);
+}
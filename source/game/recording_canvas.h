@@ -0,0 +1,111 @@
+//---------------------------------------------------------------------------
+// PROJECT      : Asteroid Style Game
+// COPYRIGHT    : Andy Thomas (C) 2019
+// WEB URL      : https://kuiper.zone
+// LICENSE      : GPLv3
+//---------------------------------------------------------------------------
+
+#ifndef GAME_RECORDING_CANVAS_H
+#define GAME_RECORDING_CANVAS_H
+
+#include "canvas_interface.h"
+
+#include <cstdint>
+#include <vector>
+
+namespace Game {
+
+//! A concrete implementation of CanvasInterface which paints nothing, but
+//! records calls made to it in a compact display list, and which can replay
+//! them to another canvas. Coordinates are recorded as given, i.e. already
+//! scaled where it serves as the device canvas of a ScaledCanvas. Calls to
+//! beginDraw() and endDraw() are recorded also, so that a frame replays as a
+//! whole, together with sounds played or stopped since the last clear().
+//! Consecutive lines are held as a single polyline, and replayed with one
+//! call to drawPolyline(). The list grows until clear() is called, which the
+//! owner is expected to do after each replay(). Text is measured by a metrics
+//! canvas, typically that to which the record is replayed, so that text is
+//! laid out as though drawn to it directly.
+class RecordingCanvas : public CanvasInterface
+{
+public:
+
+    //! Constructor with canvas dimensions. Without a metrics canvas, the
+    //! height returned by drawText() and textHeight() is nominal, as
+    //! NullCanvas.
+    RecordingCanvas(double width = 1280, double height = 720);
+
+    //! Constructor with a metrics canvas, from which width(), height() and
+    //! textHeight() are taken. It is not drawn to, and must remain valid for
+    //! the lifetime of this instance.
+    explicit RecordingCanvas(const CanvasInterface *metrics);
+
+    //! Sets the canvas dimensions. Ignored where there is a metrics canvas.
+    void setSize(double width, double height);
+
+    //! Discards all recorded calls. Memory is retained for reuse.
+    void clear();
+
+    //! Returns true if nothing is recorded.
+    bool empty() const;
+
+    //! The number of commands recorded, where a run of consecutive
+    //! lines counts as one.
+    std::size_t commandCount() const;
+
+    //! The number of points held by recorded lines, including breaks.
+    std::size_t pointCount() const;
+
+    //! Makes the recorded calls to dest in the order recorded. The record
+    //! is unchanged, so that it may be replayed to more than one canvas.
+    void replay(CanvasInterface *dest) const;
+
+    // Implements CanvasInterface.
+    double width() const override;
+    double height() const override;
+    void beginDraw() override;
+    void endDraw() override;
+    void drawLine(const PairXy &p1, const PairXy &p2) override;
+    void drawPolyline(const PairXy *points, std::size_t count) override;
+    double drawText(const PairXy &pos, AlignHorz horz, AlignVert vert,
+        double rem, const std::string &text) override;
+    double textHeight(double rem, const std::string &text) const override;
+    void playSound(SoundId id, SoundOpt opt) override;
+    void stopSound(SoundId id) override;
+
+private:
+
+    enum class Op : std::uint8_t
+    {
+        Begin,
+        End,
+        Lines,
+        Text,
+        Play,
+        Stop,
+    };
+
+    // Points of Lines and Text, and characters of Text, are
+    // held in order in _points and _text, and so need no index
+    struct Command
+    {
+        Op op;
+        std::uint8_t arg1;
+        std::uint8_t arg2;
+        std::uint32_t count;
+        double rem;
+    };
+
+    double _width {0};
+    double _height {0};
+    const CanvasInterface *_metrics {nullptr};
+    std::vector<Command> _commands;
+    std::vector<PairXy> _points;
+    std::string _text;
+
+    void add(Op op, std::uint8_t arg1 = 0, std::uint8_t arg2 = 0,
+        std::uint32_t count = 0, double rem = 0);
+};
+
+} // namespace
+#endif
@@ -0,0 +1,27 @@
+#-------------------------------------------------
+# HEADLESS RUNNER
+#-------------------------------------------------
+# Command line program which advances the game as
+# fast as possible with no display, and reports
+# throughput and memory use. See main.cpp.
+
+TARGET = "AsteroidHeadless"
+TEMPLATE = app
+CONFIG *= console
+CONFIG -= qt app_bundle
+
+include(../common.pri)
+include(../game/game.pri)
+
+DESTDIR = $$OUT_PWD/bin
+
+win32: LIBS += -lpsapi
+
+HEADERS += \
+    peak_memory.h \
+    state_trace.h
+
+SOURCES += \
+    main.cpp \
+    peak_memory.cpp \
+    state_trace.cpp
@@ -0,0 +1,382 @@
+//---------------------------------------------------------------------------
+// PROJECT      : Asteroid Style Game
+// COPYRIGHT    : Andy Thomas (C) 2019
+// WEB URL      : https://kuiper.zone
+// LICENSE      : GPLv3
+//---------------------------------------------------------------------------
+
+// Advances the game as fast as possible with no display, and reports ticks
+// per second, entity counts and peak memory. By default, the game is played
+// by the autopilot of the demo. Alternatively, an input log recorded by the
+// application (see --record) is replayed.
+//
+// To validate a float build (see game/real.h), write a trace with the double
+// build using --trace, then run the float build with the same options and
+// --drift to report how far, and for how long, the two agree.
+
+#include "peak_memory.h"
+#include "state_trace.h"
+
+#include "game/null_canvas.h"
+#include "game/player.h"
+#include "game/input_log.h"
+#include "game/real.h"
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+#include <vector>
+
+using namespace Game;
+
+namespace {
+
+struct Options
+{
+    std::int64_t ticks {-1};
+    std::uint64_t seed {1};
+    int threads {1};
+    double width {1280};
+    double height {720};
+    bool draw {false};
+    std::string replay;
+    std::string trace;
+    std::string drift;
+    int interval {60};
+};
+
+// Optional trace writer and drift comparison
+struct Checks
+{
+    StateTrace trace;
+    DriftMeter drift;
+    bool tracing {false};
+    bool drifting {false};
+
+    void sample(const Player &player, std::int64_t tick)
+    {
+        if (tracing) trace.sample(player, tick);
+        if (drifting) drift.sample(player, tick);
+    }
+};
+
+// Entity counts at end of run and peak total
+struct Census
+{
+    std::vector<std::int64_t> kind;
+    std::int64_t total {0};
+    std::int64_t peak {0};
+    std::int64_t drawn {0};
+    std::int64_t culled {0};
+
+    // Called every tick, after draw() if drawing
+    void sample(const Player &player)
+    {
+        Player::Stats stats = player.stats();
+
+        drawn += stats.drawn;
+        culled += stats.culled;
+
+        if (stats.entities > peak)
+        {
+            peak = stats.entities;
+        }
+    }
+
+    // Called at end
+    void count(const Player &player)
+    {
+        std::vector<Player::EntityState> entities;
+        player.entities(entities);
+
+        kind.assign(Player::KindCount, 0);
+        total = static_cast<std::int64_t>(entities.size());
+
+        for(std::size_t n = 0; n < entities.size(); ++n)
+        {
+            kind[entities[n].kind] += 1;
+        }
+
+        if (total > peak)
+        {
+            peak = total;
+        }
+    }
+};
+
+void printUsage()
+{
+    std::printf(
+        "Usage: AsteroidHeadless [options]\n"
+        "  --ticks N      Number of ticks to run (default 36000, or length of replay)\n"
+        "  --seed N       Random seed (default 1). Ignored with --replay or --drift.\n"
+        "  --threads N    Threads used by the collision phase (default 1)\n"
+        "  --simd LEVEL   Kernel level: scalar, sse2, sse4.2, avx2 or avx512\n"
+        "                 (default: detected, or ASTEROID_SIMD if set)\n"
+        "  --size WxH     Canvas size (default 1280x720)\n"
+        "  --draw         Call draw() after each tick\n"
+        "  --replay FILE  Replay an input log recorded by the application\n"
+        "  --trace FILE   Write entity positions to FILE at intervals\n"
+        "  --drift FILE   Compare with a trace written by --trace, i.e. by\n"
+        "                 another build, and report the drift\n"
+        "  --interval N   Ticks between trace samples (default 60)\n"
+        "  --help         Show this message\n");
+}
+
+bool parseArgs(int argc, char *argv[], Options &opts)
+{
+    for(int n = 1; n < argc; ++n)
+    {
+        std::string arg = argv[n];
+        const char *value = n + 1 < argc ? argv[n + 1] : nullptr;
+
+        if (arg == "--draw")
+        {
+            opts.draw = true;
+            continue;
+        }
+
+        if (value == nullptr)
+        {
+            return false;
+        }
+
+        n += 1;
+
+        if (arg == "--ticks")
+        {
+            opts.ticks = std::strtoll(value, nullptr, 10);
+        }
+        else
+        if (arg == "--seed")
+        {
+            opts.seed = std::strtoull(value, nullptr, 10);
+        }
+        else
+        if (arg == "--threads")
+        {
+            opts.threads = std::atoi(value);
+        }
+        else
+        if (arg == "--simd")
+        {
+            // For all Player instances created hereafter
+            if (!Player::setSimdLevel(value))
+            {
+                return false;
+            }
+        }
+        else
+        if (arg == "--size")
+        {
+            if (std::sscanf(value, "%lfx%lf", &opts.width, &opts.height) != 2)
+            {
+                return false;
+            }
+        }
+        else
+        if (arg == "--replay")
+        {
+            opts.replay = value;
+        }
+        else
+        if (arg == "--trace")
+        {
+            opts.trace = value;
+        }
+        else
+        if (arg == "--drift")
+        {
+            opts.drift = value;
+        }
+        else
+        if (arg == "--interval")
+        {
+            opts.interval = std::atoi(value);
+        }
+        else
+        {
+            return false;
+        }
+    }
+
+    return opts.threads > 0 && opts.width > 0 && opts.height > 0 && opts.interval > 0;
+}
+
+void report(const Options &opts, std::int64_t ticks, double seconds,
+    const Census &census, const NullCanvas &canvas, const Checks &checks)
+{
+    double rate = seconds > 0 ? ticks / seconds : 0;
+
+    std::printf("Ticks: %lld\n", static_cast<long long>(ticks));
+    std::printf("Seconds: %.3f\n", seconds);
+    std::printf("Ticks/s: %.1f\n", rate);
+    std::printf("Realtime factor: %.1f\n", rate * Player::PollInterval / 1000.0);
+    std::printf("Threads: %d\n", opts.threads);
+    std::printf("Precision: %s\n", realName());
+    std::printf("SIMD: %s\n", Player::simdLevel().c_str());
+
+    if (opts.draw)
+    {
+        std::printf("Lines drawn: %lld\n", static_cast<long long>(canvas.lineCount()));
+        std::printf("Entities drawn: %lld (culled %lld)\n",
+            static_cast<long long>(census.drawn), static_cast<long long>(census.culled));
+    }
+
+    std::printf("Entities: %lld (peak %lld)\n",
+        static_cast<long long>(census.total), static_cast<long long>(census.peak));
+
+    for(int n = 0; n < Player::KindCount; ++n)
+    {
+        std::printf("  %-12s %lld\n", Player::kindName(n).c_str(), static_cast<long long>(census.kind[n]));
+    }
+
+    std::printf("Peak memory: %.1f MB\n", peakMemory() / (1024.0 * 1024.0));
+
+    if (checks.drifting)
+    {
+        checks.drift.report();
+    }
+}
+
+int runUniverse(const Options &opts, Checks &checks)
+{
+    NullCanvas canvas(opts.width, opts.height);
+    Player player(&canvas, opts.seed);
+    player.setAutopilot(true);
+    player.setThreadCount(opts.threads);
+
+    std::int64_t ticks = opts.ticks >= 0 ? opts.ticks : 36000;
+    Census census;
+
+    auto t0 = std::chrono::steady_clock::now();
+
+    for(std::int64_t n = 0; n < ticks; ++n)
+    {
+        player.advance();
+
+        if (opts.draw)
+        {
+            player.draw();
+        }
+
+        census.sample(player);
+        checks.sample(player, n + 1);
+    }
+
+    auto t1 = std::chrono::steady_clock::now();
+    census.count(player);
+
+    std::printf("Mode: autopilot, seed %llu\n", static_cast<unsigned long long>(opts.seed));
+    report(opts, ticks, std::chrono::duration<double>(t1 - t0).count(), census, canvas, checks);
+    return 0;
+}
+
+int runReplay(const Options &opts, Checks &checks)
+{
+    InputLog log;
+
+    if (!log.load(opts.replay))
+    {
+        std::fprintf(stderr, "Failed to load input log: %s\n", opts.replay.c_str());
+        return 1;
+    }
+
+    NullCanvas canvas(opts.width, opts.height);
+    Player player(&canvas, log.seed());
+    player.replay(&log);
+    player.setThreadCount(opts.threads);
+
+    std::int64_t ticks = opts.ticks;
+
+    if (ticks < 0)
+    {
+        // Up to and including last event
+        ticks = log.size() > 0 ? log.at(log.size() - 1).tick + 1 : 0;
+    }
+
+    Census census;
+
+    auto t0 = std::chrono::steady_clock::now();
+
+    for(std::int64_t n = 0; n < ticks; ++n)
+    {
+        player.advance();
+
+        if (opts.draw)
+        {
+            player.draw();
+        }
+
+        census.sample(player);
+        checks.sample(player, n + 1);
+    }
+
+    auto t1 = std::chrono::steady_clock::now();
+    census.count(player);
+
+    std::printf("Mode: replay %s, %zu events, seed %llu\n", opts.replay.c_str(),
+        log.size(), static_cast<unsigned long long>(log.seed()));
+    report(opts, ticks, std::chrono::duration<double>(t1 - t0).count(), census, canvas, checks);
+    return 0;
+}
+
+} // namespace
+
+int main(int argc, char *argv[])
+{
+    Options opts;
+
+    if (!parseArgs(argc, argv, opts))
+    {
+        printUsage();
+        return argc > 1 && std::strcmp(argv[1], "--help") == 0 ? 0 : 1;
+    }
+
+    Checks checks;
+
+    if (!opts.drift.empty())
+    {
+        if (!checks.drift.open(opts.drift))
+        {
+            std::fprintf(stderr, "Failed to load trace: %s\n", opts.drift.c_str());
+            return 1;
+        }
+
+        // Same game as the trace
+        opts.seed = checks.drift.seed();
+        checks.drifting = true;
+    }
+
+    if (!opts.trace.empty())
+    {
+        std::uint64_t seed = opts.seed;
+
+        if (!opts.replay.empty())
+        {
+            // Seed is that of the log. Loaded again by runReplay().
+            InputLog log;
+            seed = log.load(opts.replay) ? log.seed() : 0;
+        }
+
+        if (!checks.trace.create(opts.trace, seed, opts.interval))
+        {
+            std::fprintf(stderr, "Failed to create trace: %s\n", opts.trace.c_str());
+            return 1;
+        }
+
+        checks.tracing = true;
+    }
+
+    int rslt = !opts.replay.empty() ? runReplay(opts, checks) : runUniverse(opts, checks);
+
+    if (checks.tracing && !checks.trace.close())
+    {
+        std::fprintf(stderr, "Failed to write trace: %s\n", opts.trace.c_str());
+        return 1;
+    }
+
+    return rslt;
+}
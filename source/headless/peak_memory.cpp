@@ -0,0 +1,42 @@
+//---------------------------------------------------------------------------
+// PROJECT      : Asteroid Style Game
+// COPYRIGHT    : Andy Thomas (C) 2019
+// WEB URL      : https://kuiper.zone
+// LICENSE      : GPLv3
+//---------------------------------------------------------------------------
+
+#include "peak_memory.h"
+
+#if defined(_WIN32)
+#include <windows.h>
+#include <psapi.h>
+#elif defined(__unix__) || defined(__APPLE__)
+#include <sys/resource.h>
+#endif
+
+std::int64_t peakMemory()
+{
+#if defined(_WIN32)
+    PROCESS_MEMORY_COUNTERS pmc;
+
+    if (GetProcessMemoryInfo(GetCurrentProcess(), &pmc, sizeof(pmc)))
+    {
+        return static_cast<std::int64_t>(pmc.PeakWorkingSetSize);
+    }
+#elif defined(__unix__) || defined(__APPLE__)
+    struct rusage usage;
+
+    if (getrusage(RUSAGE_SELF, &usage) == 0)
+    {
+#if defined(__APPLE__)
+        // Bytes on macOS
+        return static_cast<std::int64_t>(usage.ru_maxrss);
+#else
+        // Kilobytes on Linux and BSD
+        return static_cast<std::int64_t>(usage.ru_maxrss) * 1024;
+#endif
+    }
+#endif
+
+    return 0;
+}
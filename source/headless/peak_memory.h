@@ -0,0 +1,17 @@
+//---------------------------------------------------------------------------
+// PROJECT      : Asteroid Style Game
+// COPYRIGHT    : Andy Thomas (C) 2019
+// WEB URL      : https://kuiper.zone
+// LICENSE      : GPLv3
+//---------------------------------------------------------------------------
+
+#ifndef HEADLESS_PEAK_MEMORY_H
+#define HEADLESS_PEAK_MEMORY_H
+
+#include <cstdint>
+
+//! Returns the peak resident memory of the process in bytes, or 0 if not
+//! known on the platform.
+std::int64_t peakMemory();
+
+#endif
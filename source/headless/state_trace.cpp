@@ -0,0 +1,260 @@
+//---------------------------------------------------------------------------
+// PROJECT      : Asteroid Style Game
+// COPYRIGHT    : Andy Thomas (C) 2019
+// WEB URL      : https://kuiper.zone
+// LICENSE      : GPLv3
+//---------------------------------------------------------------------------
+
+#include "state_trace.h"
+
+#include "game/real.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <type_traits>
+
+using namespace Game;
+
+namespace {
+
+// File signature and format version. Values are in native byte order,
+// as traces are intended for comparison on the machine which wrote them.
+// Header: magic, version, precision ('d', 'f' or 'x'), interval, seed.
+// Sample: tick, score, count, then count of (serial, x, y).
+const char Magic[4] = {'A', 'A', 'T', 'R'};
+const std::uint8_t Version = 1;
+
+char precisionCode()
+{
+    return std::is_same<Real, Fixed>::value ? 'x' : (std::is_same<Real, float>::value ? 'f' : 'd');
+}
+
+template <typename T>
+bool put(std::FILE *file, T value)
+{
+    return std::fwrite(&value, sizeof(T), 1, file) == 1;
+}
+
+template <typename T>
+bool get(std::FILE *file, T &value)
+{
+    return std::fread(&value, sizeof(T), 1, file) == 1;
+}
+
+} // namespace
+
+//---------------------------------------------------------------------------
+// CLASS StateTrace : PUBLIC MEMBERS
+//---------------------------------------------------------------------------
+StateTrace::~StateTrace()
+{
+    close();
+}
+
+bool StateTrace::create(const std::string &path, std::uint64_t seed, int interval)
+{
+    close();
+
+    _file = std::fopen(path.c_str(), "wb");
+    _interval = std::max(interval, 1);
+    _ok = _file != nullptr;
+
+    if (_ok)
+    {
+        _ok = std::fwrite(Magic, sizeof(Magic), 1, _file) == 1
+            && put<std::uint8_t>(_file, Version)
+            && put<char>(_file, precisionCode())
+            && put<std::int32_t>(_file, _interval)
+            && put<std::uint64_t>(_file, seed);
+    }
+
+    return _ok;
+}
+
+void StateTrace::sample(const Player &player, std::int64_t tick)
+{
+    if (_file == nullptr || tick % _interval != 0)
+    {
+        return;
+    }
+
+    player.entities(_entities);
+
+    _ok = _ok && put<std::int64_t>(_file, tick)
+        && put<std::int32_t>(_file, player.stats().score)
+        && put<std::uint32_t>(_file, static_cast<std::uint32_t>(_entities.size()));
+
+    for(std::size_t n = 0; _ok && n < _entities.size(); ++n)
+    {
+        const Player::EntityState &e = _entities[n];
+
+        _ok = put<std::uint64_t>(_file, e.serial)
+            && put<double>(_file, e.position.x())
+            && put<double>(_file, e.position.y());
+    }
+}
+
+bool StateTrace::close()
+{
+    if (_file != nullptr)
+    {
+        _ok = std::fclose(_file) == 0 && _ok;
+        _file = nullptr;
+    }
+
+    return _ok;
+}
+
+//---------------------------------------------------------------------------
+// CLASS DriftMeter : PUBLIC MEMBERS
+//---------------------------------------------------------------------------
+DriftMeter::~DriftMeter()
+{
+    if (_file != nullptr)
+    {
+        std::fclose(_file);
+    }
+}
+
+bool DriftMeter::open(const std::string &path)
+{
+    _path = path;
+    _file = std::fopen(path.c_str(), "rb");
+
+    if (_file == nullptr)
+    {
+        return false;
+    }
+
+    char magic[sizeof(Magic)];
+    std::uint8_t version;
+    char precision;
+    std::int32_t interval;
+
+    if (std::fread(magic, sizeof(magic), 1, _file) != 1 || std::memcmp(magic, Magic, sizeof(Magic)) != 0
+        || !get(_file, version) || version != Version || !get(_file, precision)
+        || !get(_file, interval) || interval < 1 || !get(_file, _seed))
+    {
+        std::fclose(_file);
+        _file = nullptr;
+        return false;
+    }
+
+    _precision = precision == 'x' ? "fixed" : (precision == 'f' ? "float" : "double");
+    _interval = interval;
+    return true;
+}
+
+void DriftMeter::sample(const Player &player, std::int64_t tick)
+{
+    if (_file == nullptr || _eof || tick % _interval != 0)
+    {
+        return;
+    }
+
+    std::int64_t refTick;
+    std::int32_t score;
+
+    if (!readSample(refTick, score) || refTick != tick)
+    {
+        // End of trace, or out of step with this run
+        _eof = true;
+        return;
+    }
+
+    player.entities(_entities);
+    _live.clear();
+
+    for(std::size_t n = 0; n < _entities.size(); ++n)
+    {
+        const Player::EntityState &e = _entities[n];
+        _live.push_back({e.serial, e.position.x(), e.position.y()});
+    }
+
+    auto bySerial = [](const Entry &a, const Entry &b) { return a.serial < b.serial; };
+    std::sort(_ref.begin(), _ref.end(), bySerial);
+    std::sort(_live.begin(), _live.end(), bySerial);
+
+    _samples += 1;
+    _lastTick = tick;
+
+    if (_divergedTick >= 0)
+    {
+        return;
+    }
+
+    bool same = _ref.size() == _live.size() && score == player.stats().score;
+
+    for(std::size_t n = 0; same && n < _live.size(); ++n)
+    {
+        same = _ref[n].serial == _live[n].serial;
+    }
+
+    if (!same)
+    {
+        _divergedTick = tick;
+        return;
+    }
+
+    for(std::size_t n = 0; n < _live.size(); ++n)
+    {
+        double drift = std::hypot(_live[n].x - _ref[n].x, _live[n].y - _ref[n].y);
+
+        if (drift > _maxDrift)
+        {
+            _maxDrift = drift;
+            _maxDriftTick = tick;
+        }
+
+        _sumDrift += drift;
+        _sumCount += 1;
+    }
+}
+
+void DriftMeter::report() const
+{
+    std::printf("Drift reference: %s (%s, every %d ticks)\n", _path.c_str(),
+        _precision, _interval);
+    std::printf("Drift samples: %lld, to tick %lld\n",
+        static_cast<long long>(_samples), static_cast<long long>(_lastTick));
+
+    if (_divergedTick >= 0)
+    {
+        std::printf("Drift diverged at tick: %lld\n", static_cast<long long>(_divergedTick));
+    }
+    else
+    {
+        std::printf("Drift diverged: no\n");
+    }
+
+    std::printf("Drift max: %.6g (tick %lld)\n", _maxDrift, static_cast<long long>(_maxDriftTick));
+    std::printf("Drift mean: %.6g\n", _sumCount > 0 ? _sumDrift / _sumCount : 0.0);
+}
+
+//---------------------------------------------------------------------------
+// CLASS DriftMeter : PRIVATE MEMBERS
+//---------------------------------------------------------------------------
+bool DriftMeter::readSample(std::int64_t &tick, std::int32_t &score)
+{
+    std::uint32_t count;
+
+    if (!get(_file, tick) || !get(_file, score) || !get(_file, count))
+    {
+        return false;
+    }
+
+    _ref.resize(count);
+
+    for(std::uint32_t n = 0; n < count; ++n)
+    {
+        Entry &e = _ref[n];
+
+        if (!get(_file, e.serial) || !get(_file, e.x) || !get(_file, e.y))
+        {
+            return false;
+        }
+    }
+
+    return true;
+}
@@ -0,0 +1,108 @@
+//---------------------------------------------------------------------------
+// PROJECT      : Asteroid Style Game
+// COPYRIGHT    : Andy Thomas (C) 2019
+// WEB URL      : https://kuiper.zone
+// LICENSE      : GPLv3
+//---------------------------------------------------------------------------
+
+#ifndef HEADLESS_STATE_TRACE_H
+#define HEADLESS_STATE_TRACE_H
+
+#include "game/player.h"
+
+#include <cstdio>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+//! Writes a trace file holding a sample of entity positions, by serial
+//! number, and the score at regular tick intervals. Values are written as
+//! double, whatever the build precision, so that a trace written by one
+//! build can be compared with a run of another. See DriftMeter.
+class StateTrace
+{
+public:
+
+    //! Destructor. Closes the file.
+    ~StateTrace();
+
+    //! Creates the file, where a sample is to be taken every interval ticks.
+    //! The result is false on failure.
+    bool create(const std::string &path, std::uint64_t seed, int interval);
+
+    //! Call after each advance(), where tick is the number of calls so far.
+    //! Writes a sample of the game when tick is a multiple of interval.
+    void sample(const Game::Player &player, std::int64_t tick);
+
+    //! Closes the file. The result is false if any write failed.
+    bool close();
+
+private:
+
+    std::FILE *_file {nullptr};
+    int _interval {1};
+    bool _ok {true};
+
+    std::vector<Game::Player::EntityState> _entities;
+};
+
+//! Compares a run with a trace written by StateTrace, typically where the
+//! trace was written by the double build and the run is of the float build,
+//! given the same seed and options. Entities are matched by serial number.
+//! The two runs are identical until an entity is created or removed in one
+//! but not the other, or the scores differ. Up to that point, the drift is
+//! the distance between the positions of matching entities. Note that an
+//! entity which wraps at an edge in one run, but not yet in the other, shows
+//! a drift of about the width of the playfield.
+class DriftMeter
+{
+public:
+
+    //! Destructor. Closes the file.
+    ~DriftMeter();
+
+    //! Opens the trace. The result is false if it cannot be read.
+    bool open(const std::string &path);
+
+    //! The seed recorded in the trace.
+    std::uint64_t seed() const { return _seed; }
+
+    //! Call after each advance(), as for StateTrace::sample(). Compares
+    //! with the trace when tick is a multiple of the trace interval.
+    void sample(const Game::Player &player, std::int64_t tick);
+
+    //! Prints the results.
+    void report() const;
+
+private:
+
+    struct Entry
+    {
+        std::uint64_t serial;
+        double x;
+        double y;
+    };
+
+    std::FILE *_file {nullptr};
+    std::string _path;
+    std::uint64_t _seed {0};
+    int _interval {1};
+    const char *_precision {""};
+    bool _eof {false};
+
+    std::vector<Entry> _ref;
+    std::vector<Entry> _live;
+    std::vector<Game::Player::EntityState> _entities;
+
+    std::int64_t _samples {0};
+    std::int64_t _lastTick {-1};
+    std::int64_t _divergedTick {-1};
+    double _maxDrift {0};
+    std::int64_t _maxDriftTick {-1};
+    double _sumDrift {0};
+    std::int64_t _sumCount {0};
+
+    bool readSample(std::int64_t &tick, std::int32_t &score);
+};
+
+#endif
@@ -126,16 +126,7 @@ void DeviceCanvas::beginDraw()
     delete _painter;
     _painter = new QPainter(_device);
 
-    QFont f = _painter->font();
-
-    // We can leave empty to use default font
-    if (!_canvasFont.isEmpty())
-    {
-        f.setFamily(_canvasFont);
-    }
-
-    _fontSize = f.pointSizeF();
-    _painter->setFont(f);
+    _painter->setFont(textFont(1));
 
     _painter->setPen(QPen(_foreground));
     _painter->fillRect(0, 0, width(), height(), _background);
@@ -156,13 +147,35 @@ void DeviceCanvas::drawLine(const PairXy& p1, const PairXy& p2)
     }
 }
 
+void DeviceCanvas::drawPolyline(const PairXy *points, std::size_t count)
+{
+    if (_painter != nullptr)
+    {
+        // All lines in a single call. Coordinates are as drawLine().
+        _lines.clear();
+
+        for(std::size_t n = 1; n < count; ++n)
+        {
+            const PairXy &p1 = points[n - 1];
+            const PairXy &p2 = points[n];
+
+            if (!p1.isNaN() && !p2.isNaN())
+            {
+                _lines.append(QLine(static_cast<int>(p1.x()), static_cast<int>(p1.y()) + _padTop,
+                    static_cast<int>(p2.x()), static_cast<int>(p2.y()) + _padTop));
+            }
+        }
+
+        _painter->drawLines(_lines);
+    }
+}
+
 double DeviceCanvas::drawText(const PairXy& pos, AlignHorz horz, AlignVert vert,
     double rem, const std::string& text)
 {
     if (_painter != nullptr && rem > 0)
     {
-        QFont f = _painter->font();
-        f.setPointSizeF(_fontSize * rem);
+        QFont f = textFont(rem);
         _painter->setFont(f);
 
         QString s = QString::fromStdString(text);
@@ -200,6 +213,17 @@ double DeviceCanvas::drawText(const PairXy& pos, AlignHorz horz, AlignVert vert,
     return 0;
 }
 
+double DeviceCanvas::textHeight(double rem, const std::string& text) const
+{
+    if (rem > 0)
+    {
+        // As drawText(), but needs no painter
+        return QFontMetrics(textFont(rem), _device).size(0, QString::fromStdString(text)).height();
+    }
+
+    return 0;
+}
+
 void DeviceCanvas::playSound(SoundId id, SoundOpt opt)
 {
     QMediaPlayer* player = getPlayer(id, opt == SoundOpt::Loop);
@@ -234,6 +258,23 @@ void DeviceCanvas::stopSound(SoundId id)
 //---------------------------------------------------------------------------
 // CLASS DeviceCanvas : PRIVATE MEMBERS
 //---------------------------------------------------------------------------
+QFont DeviceCanvas::textFont(double rem) const
+{
+    // Independent of the painter, so that text may be measured at any
+    // time, but that of the widget, as the painter starts with. The
+    // device is the widget given on construction. We can leave empty
+    // to use default font.
+    QFont f = static_cast<QWidget*>(_device)->font();
+
+    if (!_canvasFont.isEmpty())
+    {
+        f.setFamily(_canvasFont);
+    }
+
+    f.setPointSizeF(f.pointSizeF() * rem);
+    return f;
+}
+
 QMediaPlayer* DeviceCanvas::getPlayer(SoundId id, bool loop)
 {
 
@@ -15,6 +15,8 @@
 #include <QColor>
 #include <QMediaPlayer>
 #include <QPaintDevice>
+#include <QVector>
+#include <QLine>
 
 namespace Game {
 
@@ -49,8 +51,10 @@ public:
     void beginDraw() override;
     void endDraw() override;
     void drawLine(const PairXy &p1, const PairXy& p2) override;
+    void drawPolyline(const PairXy *points, std::size_t count) override;
     double drawText(const PairXy &pos, AlignHorz horz, AlignVert vert,
         double rem, const std::string &text) override;
+    double textHeight(double rem, const std::string &text) const override;
     void playSound(SoundId id, SoundOpt opt) override;
     void stopSound(SoundId id) override;
 
@@ -60,10 +64,9 @@ private:
     int _padTop {0};
     int _padBottom {0};
     QPainter *_painter {nullptr};
+    QVector<QLine> _lines;
     QColor _foreground {0x45C6D6};
     QColor _background {0x2E2F30};
-    double _fontSize;
-
     QString _canvasFont;
 
     // We keep a separate QMediaPlayer instance for each sound type
@@ -93,6 +96,7 @@ private:
     QMediaPlayer *_gunPlayer;
     bool _gunLoop {false};
 
+    QFont textFont(double rem) const;
     QMediaPlayer* getPlayer(SoundId id, bool loop);
 
     // Used to loop play
@@ -6,15 +6,36 @@
 //---------------------------------------------------------------------------
 
 #include "main_window.h"
+#include "game/player.h"
 
 #include <QApplication>
+#include <QCommandLineParser>
 
 int main(int argc, char *argv[])
 {
     QApplication::setAttribute(Qt::AA_EnableHighDpiScaling);
     QApplication app(argc, argv);
 
-    MainWindow gui;
+    QCommandLineParser parser;
+    parser.addHelpOption();
+
+    // Input log which may be replayed with Player::replay()
+    QCommandLineOption recordOption("record", "Record game input to <file>.", "file");
+    parser.addOption(recordOption);
+
+    // Forces the level of SIMD kernels, overriding ASTEROID_SIMD
+    QCommandLineOption simdOption("simd", "Use SIMD kernels of <level>: scalar, sse2, "
+        "sse4.2, avx2 or avx512. The default is the best supported.", "level");
+    parser.addOption(simdOption);
+    parser.process(app);
+
+    if (parser.isSet(simdOption)
+        && !Game::Player::setSimdLevel(parser.value(simdOption).toStdString()))
+    {
+        parser.showHelp(1);
+    }
+
+    MainWindow gui(nullptr, parser.value(recordOption));
     gui.showMaximized();
 
     return app.exec();
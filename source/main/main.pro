@@ -0,0 +1,60 @@
+#-------------------------------------------------
+# APPLICATION META
+#-------------------------------------------------
+TARGET_MAJOR=2
+TARGET_MINOR=0
+TARGET_PATCH=1
+VERSION = $${TARGET_MAJOR}.$${TARGET_MINOR}.$${TARGET_PATCH}
+DEFINES += "APP_VERSION=\"\\\"$${VERSION}\\\"\""
+
+QMAKE_TARGET_PRODUCT = "ASTEROID ARCADE"
+QMAKE_TARGET_COMPANY = "Andy Thomas"
+QMAKE_TARGET_COPYRIGHT = "Andy Thomas 2021"
+QMAKE_TARGET_DESCRIPTION = "Open Source Arcade Game"
+
+#-------------------------------------------------
+# CONFIGURATION
+#-------------------------------------------------
+TARGET = "AsteroidArcade"
+TEMPLATE = app
+QT *= core gui widgets multimedia
+
+include(../common.pri)
+include(../game/game.pri)
+
+RCC_DIR = $$OUT_PWD/tmp/rcc
+MOC_DIR = $$OUT_PWD/tmp/moc
+UI_DIR = $$OUT_PWD/tmp/uic
+DESTDIR = $$OUT_PWD/bin
+
+#-------------------------------------------------
+# EXTERNAL LIBS
+#-------------------------------------------------
+# none
+
+#-------------------------------------------------
+# POST PROCESSING
+#-------------------------------------------------
+# none
+
+#-------------------------------------------------
+# SOURCE FILES & RESOURCES
+#-------------------------------------------------
+
+win32:RC_ICONS += ../res/app_icon.ico
+RESOURCES += ../res/resources.qrc
+
+HEADERS += \
+    about_dialog.h \
+    device_canvas.h \
+    main_window.h
+
+SOURCES += \
+    about_dialog.cpp \
+    device_canvas.cpp \
+    main.cpp \
+    main_window.cpp
+
+FORMS += \
+    ../ui/main_window.ui \
+    ../ui/about_dialog.ui
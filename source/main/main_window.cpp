@@ -12,12 +12,13 @@
 
 #include "device_canvas.h"
 #include "game/player.h"
+#include "game/input_log.h"
 
 //---------------------------------------------------------------------------
 // CLASS MainWindow : PUBLIC MEMBERS
 //---------------------------------------------------------------------------
-MainWindow::MainWindow(QWidget *parent) :
-    QMainWindow(parent)
+MainWindow::MainWindow(QWidget *parent, const QString &recordPath) :
+    QMainWindow(parent), _recordPath(recordPath)
 {
     _ui = new Ui::MainWindow();
     _ui->setupUi(this);
@@ -30,6 +31,13 @@ MainWindow::MainWindow(QWidget *parent) :
     Game::DeviceCanvas *canvas = new Game::DeviceCanvas(this, 0, 0);
 
     _player = new Game::Player(canvas);
+
+    if (!_recordPath.isEmpty())
+    {
+        _log = new Game::InputLog();
+        _player->record(_log);
+    }
+
     connect(&_pollTimer, &QTimer::timeout, this, &MainWindow::advanceUniverse);
 
     _dialog = new AboutDialog(this);
@@ -38,6 +46,16 @@ MainWindow::MainWindow(QWidget *parent) :
 MainWindow::~MainWindow()
 {
     delete _player;
+
+    if (_log != nullptr)
+    {
+        if (!_log->save(_recordPath.toStdString()))
+        {
+            qWarning() << "Failed to write input log:" << _recordPath;
+        }
+
+        delete _log;
+    }
 }
 
 //---------------------------------------------------------------------------
@@ -18,6 +18,7 @@ namespace Ui { class MainWindow; }
 
 namespace Game {
 class Player;
+class InputLog;
 }
 
 class MainWindow : public QMainWindow
@@ -26,7 +27,9 @@ class MainWindow : public QMainWindow
 
 public:
 
-    explicit MainWindow(QWidget *parent = nullptr);
+    //! If recordPath is not empty, game input is recorded
+    //! and written to the file on destruction.
+    explicit MainWindow(QWidget *parent = nullptr, const QString &recordPath = QString());
     ~MainWindow();
 
 protected:
@@ -52,6 +55,8 @@ private:
     Ui::MainWindow *_ui;
     QTimer _pollTimer;
     Game::Player *_player;
+    Game::InputLog *_log {nullptr};
+    QString _recordPath;
     AboutDialog *_dialog;
 
     void advanceUniverse();